@@ -23,8 +23,15 @@ our %EXPORT_TAGS = (
         await
         async
         async_value
+        async_value_alias
         async_error
         async_cancel
+        async_loop
+        async_continue
+        async_scope
+        async_all
+        async_any
+        async_race
         async_yield
     /],
 );
@@ -67,6 +74,9 @@ Loading
     use Async::Trampoline qw(
         await
         async async_value async_error async_cancel
+        async_loop async_continue
+        async_scope
+        async_all async_any async_race
         async_yield
     );
 
@@ -79,6 +89,8 @@ Creating Asyncs
     $async = async_error "oops";
     $async = async_cancel;
     $async = async { ...; return $new_async };
+    $async = async_loop $state, sub { ...; return async_continue $new_state };
+    $async = async_scope { my ($scope) = @_; ...; return $new_async };
 
 Running Asyncs
 
@@ -118,6 +130,17 @@ Combining Asyncs
 
     $async = $x->concat($y);
 
+    $async = async_all $x, $y;
+    $async = async_any $x, $y;
+    $async = async_race $x, $y;
+
+    $async = $x->match(
+        value   => sub { my (@values) = @_; return $new_async },
+        error   => sub { my ($error) = @_; return $new_async },
+        cancel  => sub { return $new_async },
+    );
+    $async = $x->finally(sub { ... });
+
 Generators
 
     $gen = async_yield async_value(1, 2, 3) => sub {
@@ -212,6 +235,19 @@ Async/recursive:
 =for test
     is "@$items", "5 4 3 2 1", q(Async/recursive);
 
+Async/loop:
+
+    my @items;
+    async_loop(5, sub {
+        my ($i) = @_;
+        return async_value if not $i;
+        push @items, $i;
+        return async_continue $i - 1;
+    })->run_until_completion;
+
+=for test
+    is "@items", "5 4 3 2 1", q(Async/loop);
+
 Async/generators:
 
     sub loop_gen {
@@ -293,6 +329,25 @@ this Async is updated to the state of the returned Async.
 Create a Value Async containing a list of values.
 Use this to return values from an Async callback.
 
+The values are copied like in an assignment,
+so temporaries like the result of a function call are taken over without copying.
+
+=head2 async_value_alias
+
+=for test
+    $value = "original";
+
+    $async = async_value_alias $value;
+
+=for test
+    $value = "changed";
+    is $async->run_until_completion, "changed", q(async_value_alias());
+
+Like C<async_value>, but the Async refers to the values themselves
+instead of copying them, similar to the aliases in C<@_>.
+Later changes to the variables are visible in the Async.
+Use this to pass large values through an Async without copying them.
+
 =head2 async_error
 
     $async = async_error $error;
@@ -309,6 +364,63 @@ Alternatively, you can C<die()> inside the Async callback.
 Create a Cancelled Async.
 Use this to abort an Async without using an error.
 
+=head2 async_loop
+
+    $async = async_loop $initial_state, sub {
+        my ($state) = @_;
+        return async_continue $next_state if $keep_going;
+        return $result_async;
+    };
+
+Create an Incomplete Async that runs the callback repeatedly.
+The callback receives the current state.
+It returns either an C<async_continue> marker with the next state,
+or an Async that becomes the result of the loop.
+
+Unlike recursion with C<async>,
+an iteration does not allocate a new Async.
+This is useful for hot loops.
+
+=head2 async_continue
+
+=for test ignore
+
+    return async_continue $next_state;
+
+=for test
+
+Continue an C<async_loop> with the next state.
+This is not an Async and may only be returned from an C<async_loop> callback.
+
+=head2 async_scope
+
+    my $scope;
+    $async = async_scope {
+        ($scope) = @_;
+        # ...
+        return $new_async;
+    };
+
+    $scope->cancel;
+
+Run the block right away with a new scope,
+and return the Async returned by the block.
+
+Every Async created while the block runs belongs to the scope,
+as does every Async created by callbacks of those Asyncs.
+Scopes created within a scope are nested in it.
+
+C<< $scope->cancel >> cancels all Incomplete Asyncs in the scope
+and in nested scopes at once.
+Their callbacks are released without being run,
+and Asyncs waiting for them continue.
+Asyncs in the scope that are created after cancellation
+are cancelled before they run.
+Asyncs created outside the scope are not affected,
+even if they are used within it.
+
+C<< $scope->is_cancelled >> checks whether the scope was cancelled.
+
 =head1 COMBINING ASYNCS
 
 =head2 await
@@ -414,6 +526,94 @@ B<Example>:
     is "@result", "1 2 3 4 5", q(concat());
 }
 
+=head2 async_all
+
+=head2 async_any
+
+=head2 async_race
+
+    $async = async_all @asyncs;
+    $async = async_any @asyncs;
+    $async = async_race @asyncs;
+
+Evaluate all Asyncs at once, and complete as soon as the outcome is decided.
+Unlike C<concat> and C<await>,
+a slow Async does not hold up the others.
+
+=over
+
+=item *
+
+C<async_all> concatenates the values of all Asyncs.
+If one Async is cancelled or fails, that is the outcome.
+
+=item *
+
+C<async_any> takes the first Value.
+If there is none, the outcome is the first Error,
+or Cancel if all Asyncs were cancelled.
+
+=item *
+
+C<async_race> takes the first Async to complete, whatever its outcome.
+
+=back
+
+Once the outcome is decided,
+the remaining Incomplete Asyncs are cancelled,
+so that they do no further work.
+Asyncs that are also used elsewhere are not cancelled,
+but are left to complete for their other users.
+
+Without arguments, C<async_all> produces an empty Value,
+and C<async_any> and C<async_race> are cancelled.
+
+B<Example>:
+
+    $async = async_any async_error("unavailable"), async { async_value "found" };
+    #=> async_value "found"
+
+=for test {
+    is $async->run_until_completion, "found", q(async_any());
+}
+
+=head2 match
+
+    $async = $dependency->match(
+        value   => sub { my (@values) = @_; ... },
+        error   => sub { my ($error) = @_; ... },
+        cancel  => sub { ... },
+    );
+
+Evaluate the C<$dependency>,
+then call the callback for its outcome.
+The callback must return an Async.
+Outcomes without callback are passed through unchanged.
+
+Unlike C<await>,
+this can handle Errors and Cancellation
+without rethrowing the error.
+
+B<Example>:
+
+    $async = (async_error "oops")->match(
+        error => sub { async_value "recovered" },
+    );
+
+=for test {
+    is $async->run_until_completion, "recovered", q(match());
+}
+
+=head2 finally
+
+    $async = $dependency->finally(sub { ... });
+
+Evaluate the C<$dependency>,
+then call the callback regardless of the outcome.
+The return value of the callback is ignored.
+The Async is updated to the state of the C<$dependency>,
+unless the callback dies.
+
 =head1 GENERATORS
 
 A B<Generator> describes an Async
@@ -565,6 +765,22 @@ Sharing Asyncs between multiple event loops may lead to unexpected results.
 If you want to use the results of an Async to continue within an Async context,
 you usually want to C<await()> the Async instead.
 
+If the C<$async> is a temporary, as in C<< async { ... }->run_until_completion >>,
+the values are returned without copying them.
+
+=head2 run_until_completion_ref
+
+=for test
+    $async = async { async_value 1, 2, 3 };
+
+    $result = $async->run_until_completion_ref;
+
+=for test
+    is "@$result", "1 2 3", q(run_until_completion_ref());
+
+Like C<run_until_completion()>,
+but returns the values in an array reference instead of a list.
+
 =head2 to_string
 
     $str = $async->to_string;
@@ -0,0 +1,115 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use utf8;
+use feature 'say';
+
+use Time::HiRes ();
+
+use Async::Trampoline ':all';
+
+my ($size, @names) = @ARGV;
+
+$size //= 100_000;
+
+if (not $size =~ /\A [0-9_]+ \z/x) {
+    die qq(Usage: $0 [SIZE [BENCHMARKS...]]\n);
+}
+
+$size =~ s/_//g;
+
+my %BENCHMARKS = (
+    async_recursion => sub {
+        my ($n) = @_;
+        return count_down_async($n);
+    },
+    async_loop => sub {
+        my ($n) = @_;
+        return async_loop $n, sub {
+            my ($i) = @_;
+            return async_value $i if not $i;
+            return async_continue $i - 1;
+        };
+    },
+    value_then_chain => sub {
+        my ($n) = @_;
+        return count_down_value_then($n);
+    },
+    # nested Flows that are evaluated without any Perl callbacks
+    flow_nesting => sub {
+        my ($n) = @_;
+        my $async = async { async_value 1 };
+        $async = $async->value_then(async_value $_) for 1 .. $n;
+        return $async;
+    },
+    gen_foreach => sub {
+        my ($n) = @_;
+        # don't hold on to the head of the stream
+        return count_down_generator($n)->gen_foreach(sub { async_value });
+    },
+    gen_map => sub {
+        my ($n) = @_;
+        return count_down_generator($n)
+            ->gen_map(sub { async_value @_ })
+            ->gen_foreach(sub { async_value });
+    },
+);
+
+sub count_down_async {
+    my ($i) = @_;
+    return async_value $i if not $i;
+    return async { count_down_async($i - 1) };
+}
+
+sub count_down_value_then {
+    my ($i) = @_;
+    return async_value $i if not $i;
+    return async_value($i)->value_then(async { count_down_value_then($i - 1) });
+}
+
+sub count_down_generator {
+    my ($i) = @_;
+    return async_cancel if not $i;
+    return async_yield async_value($i) => sub {
+        return count_down_generator($i - 1);
+    };
+}
+
+# Resident memory in bytes, as far as the OS tells us.
+sub resident_memory {
+    open my $fh, '<', '/proc/self/status' or return 0;
+    while (<$fh>) {
+        return $1 * 1024 if /\A VmRSS: \s+ (\d+) \s+ kB/x;
+    }
+    return 0;
+}
+
+@names = sort keys %BENCHMARKS if not @names;
+
+for my $name (@names) {
+    my $make_async = $BENCHMARKS{$name}
+        or die qq($0: unknown benchmark "$name"\n);
+
+    my $rss_before = resident_memory();
+    my $async = $make_async->($size);
+    my $rss_graph = resident_memory() - $rss_before;
+
+    my $before = Async::Trampoline::_stats();
+    my $start = Time::HiRes::time();
+    $async->run_until_completion;
+    my $elapsed = Time::HiRes::time() - $start;
+    my $after = Async::Trampoline::_stats();
+
+    my $evals = $after->{eval_steps} - $before->{eval_steps};
+    # only counted with -DASYNC_TRAMPOLINE_REFCOUNT_STATS=1
+    my $refcount_ops = '-';
+    $refcount_ops = sprintf '%.2f',
+        ($after->{refcount_ops} - $before->{refcount_ops}) / ($evals || 1)
+        if exists $after->{refcount_ops};
+
+    say sprintf "%-20s %10d steps %8.3f s %8.0f ns/step %6s refcount ops/eval %6.1f B/step",
+        $name, $size, $elapsed, 1e9 * $elapsed / $size,
+        $refcount_ops,
+        $rss_graph / $size;
+}
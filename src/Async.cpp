@@ -1,42 +1,101 @@
 #include "Async.h"
+#include "Scope.h"
 
 #include <cassert>
+#include <vector>
+
+thread_local Async_Stats Async_stats {};
+
+// Asyncs whose last reference was dropped while another Async was deleted.
+// They are deleted by the outermost unref() in a loop,
+// so that releasing a deep graph doesn't recurse once per node.
+// Per thread, like the current scope.
+static thread_local std::vector<Async*> deferred_deletes{};
+static thread_local bool is_deleting = false;
+
+static void delete_async(Async* async)
+{
+    ASYNC_LOG_DEBUG("deleting Async at %p\n", async);
+
+    Async_stats.live_nodes--;
+
+    async->set_scope(nullptr);
+
+    delete async;
+}
 
 auto Async::alloc() -> AsyncRef
 {
     AsyncRef ref{new Async{}, AsyncRef::no_inc};
 
+    Async_stats.live_nodes++;
+    Async_stats.allocated_nodes++;
+
+    ref->set_scope(Async_Trampoline_Scope::current);
+
     ASYNC_LOG_DEBUG("created new Async at %p\n", ref.decay());
 
     return ref;
 }
 
-auto Async::unref() -> void
+auto Async::destroy() -> void
 {
-    refcount--;
+    assert(refcount == 0);
 
-    if (refcount)
+    if (is_deleting)
+    {
+        deferred_deletes.push_back(this);
         return;
+    }
+
+    is_deleting = true;
+
+    delete_async(this);
 
-    ASYNC_LOG_DEBUG("deleting Async at %p\n", this);
+    while (!deferred_deletes.empty())
+    {
+        Async* next = deferred_deletes.back();
+        deferred_deletes.pop_back();
+        delete_async(next);
+    }
 
-    delete this;
+    is_deleting = false;
 }
 
-auto Async::ptr_follow() -> Async&
+auto Async::ptr_follow_chain() -> Async&
 {
-    if (type != Async_Type::IS_PTR)
-        return *this;
+    assert(type == Async_Type::IS_PTR);
+
+    // find the concrete target without touching any refcounts
+    Async* target = as_ptr.decay();
+    size_t hops = 1;
+    while (target->type == Async_Type::IS_PTR)
+    {
+        target = target->as_ptr.decay();
+        hops++;
+    }
+
+    Async_stats.ptr_hops += hops;
+    if (hops > Async_stats.ptr_chain_max)
+        Async_stats.ptr_chain_max = hops;
 
-    // flatten the pointer until we reach something concrete
-    AsyncRef& ptr = as_ptr;
-    while (ptr->type == Async_Type::IS_PTR)
-        ptr = ptr->as_ptr;
+    // flatten the pointer so that the next lookup takes a single hop
+    if (hops > 1)
+        as_ptr = target;
 
-    return ptr.get();
+    return *target;
 }
 
-auto Async::add_blocked(AsyncRef b) -> void
+auto Async::set_scope(Async_Trampoline_Scope* new_scope) -> void
 {
-    ptr_follow().blocked.emplace_back(std::move(b));
+    if (scope == new_scope)
+        return;
+
+    if (scope)
+        scope->remove_member(*this);
+
+    scope = new_scope;
+
+    if (scope)
+        scope->add_member(*this);
 }
@@ -1,9 +1,10 @@
 #pragma once
-#include "Destructible.h"
+#include "ValuePolicy.h"
 #include "NoexceptSwap.h"
 
 #include <cassert>
 #include <functional>
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -23,6 +24,12 @@ static inline void _async_log_debug_ignoreall(Args&&...) { }
 } while (0)
 #endif /* ifndef ASYNC_TRAMPOLINE_DEBUG */
 
+// Counting refcount operations writes to a global on the hottest path,
+// so it must be requested with -DASYNC_TRAMPOLINE_REFCOUNT_STATS=1.
+#ifndef ASYNC_TRAMPOLINE_REFCOUNT_STATS
+#define ASYNC_TRAMPOLINE_REFCOUNT_STATS 0
+#endif
+
 #define ASYNC_FORMAT "<Async %p %s ref=%zu blocks=%zu>"
 #define ASYNC_FORMAT_ARGS(aptr)                                             \
     (aptr),                                                                 \
@@ -36,7 +43,7 @@ static inline void _async_log_debug_ignoreall(Args&&...) { }
 #define MAYBE_MOVEREF
 #endif
 
-enum class Async_Type
+enum class Async_Type : unsigned char
 {
     IS_UNINITIALIZED,
 
@@ -44,8 +51,11 @@ enum class Async_Type
     IS_PTR,
     IS_RAWTHUNK,
     IS_THUNK,
+    IS_LOOP,
     IS_CONCAT,
     IS_FLOW,
+    IS_SEQ,
+    IS_SELECT,
 
     CATEGORY_COMPLETE,
     IS_CANCEL,
@@ -65,8 +75,11 @@ Async_Type_name(enum Async_Type type)
         case Async_Type::IS_PTR:                return "IS_PTR";
         case Async_Type::IS_RAWTHUNK:           return "IS_RAWTHUNK";
         case Async_Type::IS_THUNK:              return "IS_THUNK";
+        case Async_Type::IS_LOOP:               return "IS_LOOP";
         case Async_Type::IS_CONCAT:             return "IS_CONCAT";
         case Async_Type::IS_FLOW:               return "IS_FLOW";
+        case Async_Type::IS_SEQ:                return "IS_SEQ";
+        case Async_Type::IS_SELECT:             return "IS_SELECT";
         case Async_Type::CATEGORY_COMPLETE:     return "CATEGORY_COMPLETE";
         case Async_Type::IS_CANCEL:             return "IS_CANCEL";
         case Async_Type::CATEGORY_RESOLVED:     return "CATEGORY_RESOLVED";
@@ -77,7 +90,14 @@ Async_Type_name(enum Async_Type type)
 }
 
 struct Async;
-
+class Async_Trampoline_Scope;
+
+/** An owning reference to an Async.
+ *
+ *  This is a plain pointer and not a handle into a node table:
+ *  each XS module links its own copy of the core,
+ *  and Asyncs are passed between them as pointers.
+ */
 class AsyncRef
 {
     Async* ptr;
@@ -127,6 +147,14 @@ public:
 
 struct Async_RawThunk
 {
+    /** Run the callback once the dependency is complete.
+     *
+     *  Unlike a Thunk, the callback receives the dependency itself
+     *  in any completed state, or nullptr if there is no dependency.
+     *
+     *  Returns: AsyncRef
+     *      the result, which may be the dependency.
+     */
     using Callback = std::function<AsyncRef(AsyncRef dependency)>;
     Callback    callback;
     AsyncRef    dependency;
@@ -147,6 +175,24 @@ struct Async_Thunk
     auto operator=(Async_Thunk&&) -> Async_Thunk& = default;
 };
 
+struct Async_Loop
+{
+    /** Run one iteration.
+     *
+     *  Any loop state is kept by the callback itself.
+     *
+     *  Returns: AsyncRef
+     *      the result of the loop,
+     *      or nullptr to run another iteration.
+     */
+    using Callback = std::function<AsyncRef()>;
+    Callback    callback;
+
+    Async_Loop(Async_Loop&&) = default;
+    ~Async_Loop() = default;
+    auto operator=(Async_Loop&&) -> Async_Loop& = default;
+};
+
 struct Async_Pair
 {
     AsyncRef left;
@@ -169,28 +215,135 @@ struct Async_Flow
     auto operator=(Async_Flow&&) -> Async_Flow& = default;
 };
 
+/** A chain of Flows with the same decision, flattened into an array.
+ *
+ *  Equivalent to Flow(...Flow(Flow(steps[0], steps[1]), steps[2])..., steps[n-1]),
+ *  but advances an index instead of replacing one node per step.
+ */
+struct Async_Seq
+{
+    std::vector<AsyncRef> steps;
+    size_t index;
+    Async_Type flow_type;
+    Async_Flow::Direction direction;
+
+    Async_Seq(Async_Seq&&) = default;
+    ~Async_Seq() = default;
+    auto operator=(Async_Seq&&) -> Async_Seq& = default;
+};
+
+/** Wait for all inputs at once, and decide as soon as the outcome is known.
+ *
+ *  ALL:    the concatenated Values, or the first Error or Cancel.
+ *  ANY:    the first Value, or the first Error if there is none,
+ *          or Cancel if all inputs were cancelled.
+ *  RACE:   the first input to complete.
+ *
+ *  Inputs that are still incomplete once the outcome is decided
+ *  are cancelled.
+ */
+struct Async_Select
+{
+    std::vector<AsyncRef> inputs;
+    enum Mode { ALL, ANY, RACE } mode;
+    size_t started_in_run;  // the run that the inputs wait in, or 0
+
+    Async_Select(Async_Select&&) = default;
+    ~Async_Select() = default;
+    auto operator=(Async_Select&&) -> Async_Select& = default;
+};
+
 struct Async_Uninitialized {};
 
+/** Per-thread counters for tests and benchmarks.
+ *
+ *  Only nodes created with Async::alloc() are counted.
+ *  Like the other core state, the counters are per thread,
+ *  and per XS module, since each module links its own copy of the core.
+ *
+ *  Exposed to Perl via Async::Trampoline::_stats().
+ */
+struct Async_Stats
+{
+    size_t live_nodes;
+    size_t allocated_nodes;
+    size_t ptr_hops;        // Ptr nodes traversed by ptr_follow()
+    size_t ptr_chain_max;   // longest Ptr chain seen by ptr_follow()
+    size_t eval_steps;      // calls to Async_eval()
+    size_t dropped_nodes;   // unreferenced Asyncs dropped without evaluation
+    size_t refcount_ops;    // calls to Async::ref() and Async::unref(),
+                            // see ASYNC_TRAMPOLINE_REFCOUNT_STATS
+};
+
+extern thread_local Async_Stats Async_stats;
+
+/** The Asyncs that are blocked on an Async.
+ *
+ *  Most Asyncs never have waiters,
+ *  so the list is only allocated once the first waiter is added.
+ */
+class Async_Blocked
+{
+    std::unique_ptr<std::vector<AsyncRef>> list;
+
+public:
+    Async_Blocked() noexcept : list{} {}
+
+    auto empty() const -> bool { return !list || list->empty(); }
+    auto size() const -> size_t { return list ? list->size() : 0; }
+
+    auto emplace_back(AsyncRef ref) -> void
+    {
+        if (!list)
+            list.reset(new std::vector<AsyncRef>{});
+        list->emplace_back(std::move(ref));
+    }
+
+    auto clear() -> void
+    {
+        if (list)
+            list->clear();
+    }
+
+    auto begin() -> AsyncRef*
+    { return list ? list->data() : nullptr; }
+    auto end() -> AsyncRef*
+    { return list ? list->data() + list->size() : nullptr; }
+
+    friend auto swap(Async_Blocked& lhs, Async_Blocked& rhs) noexcept -> void
+    {
+        noexcept_member_swap(lhs, rhs,
+                &Async_Blocked::list);
+    }
+};
+
 struct Async
 {
     Async_Type type;
     size_t refcount;
+    Async_Blocked blocked;
+    Async_Trampoline_Scope* scope;
+
     union {
         Async_Uninitialized as_uninitialized;
         AsyncRef            as_ptr;
+        Destructible        as_error;
+        DestructibleTuple   as_value;
+        Async_RawThunk      as_rawthunk;
         Async_Thunk         as_thunk;
+        Async_Loop          as_loop;
         Async_Pair          as_binary;
         Async_Flow          as_flow;
-        Destructible        as_error;
-        DestructibleTuple   as_value;
+        Async_Seq           as_seq;
+        Async_Select        as_select;
     };
-    std::vector<AsyncRef> blocked;
 
     Async() :
         type{Async_Type::IS_UNINITIALIZED},
         refcount{1},
-        as_ptr{nullptr},
-        blocked{}
+        blocked{},
+        scope{nullptr},
+        as_ptr{nullptr}
     { }
     Async(Async&& other) : Async{} { set_from(std::move(other)); }
     ~Async() {
@@ -199,8 +352,15 @@ struct Async
         assert(type == Async_Type::IS_UNINITIALIZED);
     }
 
-    auto ref() noexcept -> Async& { refcount++; return *this; }
-    auto unref() -> void;
+    auto ref() noexcept -> Async&
+    {
+        if (ASYNC_TRAMPOLINE_REFCOUNT_STATS)
+            Async_stats.refcount_ops++;
+        refcount++;
+        return *this;
+    }
+    inline auto unref() -> void;
+    auto destroy() -> void;  // once the refcount dropped to zero
 
     auto operator=(Async& other) -> Async&;
     auto clear() -> void;
@@ -209,15 +369,21 @@ struct Async
     void set_to_Ptr         (AsyncRef target);
     void set_to_RawThunk    (Async_RawThunk::Callback callback, AsyncRef dep);
     void set_to_Thunk       (Async_Thunk::Callback    callback, AsyncRef dep);
+    void set_to_Loop        (Async_Loop::Callback     callback);
     void set_to_Concat      (AsyncRef left, AsyncRef right);
     void set_to_Flow        (Async_Flow);
+    void set_to_Seq         (Async_Seq);
+    void set_to_Select      (Async_Select);
     void set_to_Cancel      ();
     void set_to_Error       (Destructible error);
     void set_to_Value       (DestructibleTuple values);
 
-    auto add_blocked(AsyncRef blocked) -> void;
+    inline auto add_blocked(AsyncRef blocked) -> void;
 
-    auto ptr_follow() -> Async&;
+    auto set_scope(Async_Trampoline_Scope* scope) -> void;
+
+    inline auto ptr_follow() -> Async&;
+    auto ptr_follow_chain() -> Async&;
 
     auto has_category(Async_Type type) -> bool
     { return ptr_follow().type >= type; }
@@ -233,6 +399,29 @@ inline AsyncRef::AsyncRef(Async* ptr) : AsyncRef{ptr, no_inc} {
         ptr->ref();
 }
 
+// The hot paths are inline, the rest is in Async.cpp.
+
+inline auto Async::unref() -> void
+{
+    if (ASYNC_TRAMPOLINE_REFCOUNT_STATS)
+        Async_stats.refcount_ops++;
+
+    if (--refcount == 0)
+        destroy();
+}
+
+inline auto Async::ptr_follow() -> Async&
+{
+    if (type != Async_Type::IS_PTR)
+        return *this;
+    return ptr_follow_chain();
+}
+
+inline auto Async::add_blocked(AsyncRef b) -> void
+{
+    ptr_follow().blocked.emplace_back(std::move(b));
+}
+
 inline auto AsyncRef::clear() -> void {
     if (ptr)
         ptr->unref();
@@ -252,11 +441,75 @@ static inline auto Async_maybe_blocked_size(Async const* ptr) noexcept -> size_t
 
 // Evaluation: Async_X_evaluate()
 // Incomplete -> Complete
+//
+// next: the Async to evaluate next, or nullptr.
+// blocked: self if it waits for next, or nullptr.
+//      Without next, self has already registered itself as a waiter.
+//
+// Both are borrowed from self, and valid until self changes.
 void
 Async_eval(
         Async*  self,
-        AsyncRef& next,
-        AsyncRef& blocked);
+        Async*& next,
+        Async*& blocked);
+
+/** Cancel a pending Async in place.
+ *
+ *  Its payload is released right away.
+ *  If a run loop is active, its waiters are woken up.
+ */
+void
+Async_cancel(
+        Async&  self);
+
+// Folding: decide the outcome from inputs that are already complete,
+// without going through the scheduler.
+
+/** Select the Cancel or Error that a Concat will resolve to.
+ *
+ *  Returns: Async*
+ *      the selected input,
+ *      or nullptr if the outcome is not yet decided.
+ */
+Async*
+Async_Concat_select(
+        AsyncRef& left,
+        AsyncRef& right);
+
+/** Concatenate the values of two Value Asyncs.
+ *
+ *  Values are moved out of inputs that are not shared.
+ */
+DestructibleTuple
+Async_Concat_values(
+        Async&  left,
+        Async&  right);
+
+/** Select the branch that a Flow will continue with.
+ *
+ *  Returns: Async*
+ *      the selected branch,
+ *      or nullptr if the left side is still incomplete.
+ */
+Async*
+Async_Flow_select(
+        Async_Flow& flow);
+
+/** Append a step to an unevaluated Flow or Seq with the same decision.
+ *
+ *  A Flow is converted into a Seq.
+ *  This modifies the Async in place,
+ *  so the caller must make sure that nobody else can observe it.
+ *
+ *  Returns: bool
+ *      whether the step was appended.
+ */
+bool
+Async_Seq_try_append(
+        Async&                  self,
+        AsyncRef                step,
+        Async_Type              flow_type,
+        Async_Flow::Direction   direction);
 
 inline auto AsyncRef::fold() -> AsyncRef&
 {
@@ -287,6 +540,8 @@ Async_has_category(
         enum Async_Type category)
 { assert(self); return self->has_category(category); }
 
+// The caller must keep a reference to the async for the whole run:
+// queued work that nothing else refers to is dropped without evaluation.
 void
 Async_run_until_completion(
         Async*  async);
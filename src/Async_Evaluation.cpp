@@ -1,10 +1,80 @@
 #include "Async.h"
 #include "Scheduler.h"
+#include "Scope.h"
 
 #define UNUSED(x) static_cast<void>(x)
 
+// The next and blocked Asyncs are borrowed:
+// they stay alive as long as self, because self refers to them.
 #define EVAL_RETURN(next_async, blocked_async) \
-    (void)  (next = next_async, blocked = blocked_async)
+    (void)  (next = borrowed(next_async), blocked = borrowed(blocked_async))
+
+static inline Async* borrowed(Async* async) { return async; }
+static inline Async* borrowed(AsyncRef& async) { return async.decay(); }
+
+// Update self to the result.
+// If the result was already complete, self completes right away
+// instead of being scheduled for another round.
+// Completeness is checked first, because the result may be moved into self.
+#define EVAL_RETURN_RESULT(self, result) do {                               \
+    bool result_is_complete =                                               \
+        (result)->has_category(Async_Type::CATEGORY_COMPLETE);              \
+    *(self) = *(result);                                                    \
+    if (result_is_complete)                                                 \
+        return EVAL_RETURN(nullptr, nullptr);                               \
+    return EVAL_RETURN((self), nullptr);                                    \
+} while (0)
+
+// How many continuations are evaluated directly
+// before the next Async is taken from the queue again.
+#ifndef ASYNC_TRAMPOLINE_HOT_LOOP_BUDGET
+#define ASYNC_TRAMPOLINE_HOT_LOOP_BUDGET 64
+#endif
+
+// Set while Async_run_until_completion() runs,
+// so that cancelled Asyncs can wake up their waiters.
+// Every thread runs its own loop.
+static thread_local Async_Trampoline_Scheduler* active_scheduler = nullptr;
+
+// Identifies the innermost run, or 0 outside of any run.
+// Waiters registered in one run are not woken by another run,
+// so an Async that registers itself must do so again in a new run.
+static thread_local size_t active_run = 0;
+static thread_local size_t last_run = 0;
+
+/** Make a scheduler active for a new run until the end of the block,
+ *  also if an exception unwinds through it.
+ */
+class Active_Scheduler_Enter
+{
+    Async_Trampoline_Scheduler* const saved;
+    size_t const saved_run;
+public:
+    explicit Active_Scheduler_Enter(Async_Trampoline_Scheduler* scheduler) :
+        saved{active_scheduler},
+        saved_run{active_run}
+    {
+        active_scheduler = scheduler;
+        active_run = ++last_run;
+    }
+
+    ~Active_Scheduler_Enter()
+    {
+        active_scheduler = saved;
+        active_run = saved_run;
+    }
+
+    Active_Scheduler_Enter(Active_Scheduler_Enter const&) = delete;
+    auto operator=(Active_Scheduler_Enter const&)
+        -> Active_Scheduler_Enter& = delete;
+};
+
+// Nothing but the run loop refers to this Async,
+// so its result could never be observed.
+static bool is_dead_work(Async const& async)
+{
+    return async.refcount == 1 && async.blocked.empty();
+}
 
 void
 Async_run_until_completion(
@@ -13,8 +83,9 @@ Async_run_until_completion(
     ASYNC_LOG_DEBUG("loop for Async %p\n", async);
 
     Async_Trampoline_Scheduler scheduler{};
+    Active_Scheduler_Enter enter{&scheduler};
 
-    scheduler.enqueue(async);
+    scheduler.enqueue(AsyncRef{async});
 
     while (scheduler.queue_size() > 0)
     {
@@ -23,36 +94,82 @@ Async_run_until_completion(
         if (!top)
             break;
 
-        Async trap;
-        AsyncRef next = &trap;
-        AsyncRef blocked = &trap;
-        Async_eval(top.decay(), next, blocked);
-
-        assert(next.decay() != &trap);
-        assert(blocked.decay() != &trap);
-
-        if (blocked)
-            assert(next);
-
-        if (next)
+        // Evaluate the continuation directly instead of going through the
+        // queue, until it completes or the budget for this turn runs out.
+        for (size_t budget = ASYNC_TRAMPOLINE_HOT_LOOP_BUDGET; top; budget--)
         {
-            scheduler.enqueue(next.decay());
+            if (is_dead_work(*top))
+            {
+                ASYNC_LOG_DEBUG("dropping unreferenced %p\n", top.decay());
+                Async_stats.dropped_nodes++;
+                break;
+            }
+
+            Async* next = nullptr;
+            Async* blocked = nullptr;
+            Async_eval(top.decay(), next, blocked);
+
+            // run again in place, keeping our reference
+            if (next == top.decay())
+            {
+                assert(!blocked);
+                if (!budget)
+                {
+                    scheduler.enqueue(std::move(top));
+                    break;
+                }
+                continue;
+            }
+
+            // Take a reference to next before we give up top,
+            // because next is borrowed from top.
+            AsyncRef next_ref{next};
 
             if (blocked)
-                scheduler.block_on(next.get(), blocked.decay());
-        }
-
-        if (top.decay() != next.decay() && top.decay() != blocked.decay())
-        {
-            ASYNC_LOG_DEBUG("completed %p\n", top.decay());
-            assert(top->has_category(Async_Type::CATEGORY_COMPLETE));
-            scheduler.complete(*top);
+            {
+                assert(blocked == top.decay());
+
+                // blocked without next:
+                // the Async has registered as a waiter itself
+                if (next)
+                    scheduler.block_on(*next, std::move(top));
+            }
+            else
+            {
+                ASYNC_LOG_DEBUG("completed %p\n", top.decay());
+                assert(top->has_category(Async_Type::CATEGORY_COMPLETE));
+                scheduler.complete(*top);
+            }
+
+            if (next_ref && !budget)
+            {
+                scheduler.enqueue(std::move(next_ref));
+                break;
+            }
+
+            top = std::move(next_ref);
         }
     }
 
     ASYNC_LOG_DEBUG("loop complete\n");
 }
 
+void
+Async_cancel(
+        Async&  self)
+{
+    assert(self.type != Async_Type::IS_PTR);
+    assert(!self.has_category(Async_Type::CATEGORY_COMPLETE));
+
+    ASYNC_LOG_DEBUG("cancel " ASYNC_FORMAT "\n", ASYNC_FORMAT_ARGS(&self));
+
+    self.clear();
+    self.set_to_Cancel();
+
+    if (active_scheduler)
+        active_scheduler->complete(self);
+}
+
 // Type-specific cases
 
 #define ENSURE_DEPENDENCY(self, dependency) do {                            \
@@ -60,24 +177,29 @@ Async_run_until_completion(
         return EVAL_RETURN((dependency), (self));                           \
 } while (0)
 
+// The callback is moved out while it runs.
+// Without it, the Async is running in an outer run loop,
+// which completes it and wakes up its waiters.
+#define ENSURE_NOT_RUNNING(self, callback) do {                             \
+    if (!(callback))                                                        \
+        return EVAL_RETURN(nullptr, (self));                                \
+} while (0)
+
 static void Async_Ptr_eval(
         Async*      self,
-        AsyncRef&   next,
-        AsyncRef&   blocked)
+        Async*&   next,
+        Async*&   blocked)
 {
     assert(self);
     assert(self->type == Async_Type::IS_PTR);
 
-    Async* dep = self->as_ptr.decay();
+    // compact the Ptr chain so that we block on the concrete target
+    Async* dep = self->as_ptr.fold().decay();
 
     ASYNC_LOG_DEBUG("eval Ptr %p dep=%p\n", self, dep);
 
     ENSURE_DEPENDENCY(self, dep);
 
-    Async* followed = &self->ptr_follow();
-    if (dep != followed)
-        self->as_ptr = followed;
-
     return EVAL_RETURN(nullptr, nullptr);
 }
 
@@ -85,23 +207,49 @@ static
 void
 Async_RawThunk_eval(
         Async*  self,
-        AsyncRef& next,
-        AsyncRef& blocked)
+        Async*& next,
+        Async*& blocked)
 {
     assert(self);
     assert(self->type == Async_Type::IS_RAWTHUNK);
 
-    UNUSED(next);
-    UNUSED(blocked);
-    assert(0);  // TODO not implemented
+    ASYNC_LOG_DEBUG(
+            "running RawThunk %p: callback=??? dependency=%p\n",
+            self,
+            self->as_rawthunk.dependency.decay());
+
+    ENSURE_NOT_RUNNING(self, self->as_rawthunk.callback);
+
+    AsyncRef& dependency = self->as_rawthunk.dependency;
+    if (dependency)
+    {
+        dependency.fold();
+        ENSURE_DEPENDENCY(self, dependency);
+    }
+
+    // Hand over our reference,
+    // so that the callback may reuse the payload of an unshared dependency.
+    // The callback is moved out in case it cancels our scope.
+    AsyncRef result{};
+    {
+        auto callback = std::move(self->as_rawthunk.callback);
+        Async_Trampoline_Scope_Enter enter{self->scope};
+        result = callback(std::move(dependency));
+    }
+    assert(result);
+
+    if (self->type == Async_Type::IS_CANCEL)
+        return EVAL_RETURN(nullptr, nullptr);
+
+    EVAL_RETURN_RESULT(self, result);
 }
 
 static
 void
 Async_Thunk_eval(
         Async*  self,
-        AsyncRef& next,
-        AsyncRef& blocked)
+        Async*& next,
+        Async*& blocked)
 {
     assert(self);
     assert(self->type == Async_Type::IS_THUNK);
@@ -111,31 +259,82 @@ Async_Thunk_eval(
             self,
             self->as_thunk.dependency.decay());
 
-    AsyncRef dependency = self->as_thunk.dependency;
-    DestructibleTuple default_value{};
-    DestructibleTuple const* values = &default_value;
+    ENSURE_NOT_RUNNING(self, self->as_thunk.callback);
+
+    // forward the dependency so that a re-run doesn't follow the Ptr again
+    if (self->as_thunk.dependency)
+        self->as_thunk.dependency.fold();
+
+    Async* dependency = self->as_thunk.dependency.decay();
     if (dependency)
     {
-        dependency.fold();
-
         ENSURE_DEPENDENCY(self, dependency);
 
         if (!dependency->has_type(Async_Type::IS_VALUE))
         {
-            *self = dependency.get();
+            *self = *dependency;
             return EVAL_RETURN(NULL, NULL);
         }
 
         assert(dependency->type == Async_Type::IS_VALUE);
-        values = &dependency->as_value;
     }
 
-    AsyncRef result = self->as_thunk.callback(*values);
+    // Take over our reference to the dependency,
+    // so that its values stay alive while the callback runs.
+    AsyncRef dependency_ref = std::move(self->as_thunk.dependency);
+    DestructibleTuple default_value{};
+    DestructibleTuple const* values =
+        dependency ? &dependency->as_value : &default_value;
+
+    // The callback is moved out in case it cancels our scope.
+    AsyncRef result{};
+    {
+        auto callback = std::move(self->as_thunk.callback);
+        Async_Trampoline_Scope_Enter enter{self->scope};
+        result = callback(*values);
+    }
     assert(result);
 
-    *self = result.get();
+    if (self->type == Async_Type::IS_CANCEL)
+        return EVAL_RETURN(nullptr, nullptr);
 
-    return EVAL_RETURN(self, nullptr);
+    EVAL_RETURN_RESULT(self, result);
+}
+
+static
+void
+Async_Loop_eval(
+        Async*  self,
+        Async*& next,
+        Async*& blocked)
+{
+    assert(self);
+    assert(self->type == Async_Type::IS_LOOP);
+
+    ASYNC_LOG_DEBUG("running Loop %p: callback=???\n", self);
+
+    ENSURE_NOT_RUNNING(self, self->as_loop.callback);
+
+    // The callback is moved out in case it cancels our scope,
+    // and put back for the next iteration.
+    auto callback = std::move(self->as_loop.callback);
+    AsyncRef result{};
+    {
+        Async_Trampoline_Scope_Enter enter{self->scope};
+        result = callback();
+    }
+
+    if (self->type == Async_Type::IS_CANCEL)
+        return EVAL_RETURN(nullptr, nullptr);
+
+    // run the next iteration in place
+    if (!result)
+    {
+        self->as_loop.callback = std::move(callback);
+        return EVAL_RETURN(self, nullptr);
+    }
+
+    EVAL_RETURN_RESULT(self, result);
 }
 
 static
@@ -149,105 +348,336 @@ select_if_either_has_type(AsyncRef& left, AsyncRef& right, Async_Type type)
     return nullptr;
 }
 
+Async*
+Async_Concat_select(
+        AsyncRef& left,
+        AsyncRef& right)
+{
+    left.fold();
+    right.fold();
+
+    for (Async_Type type : { Async_Type::IS_CANCEL, Async_Type::IS_ERROR })
+    {
+        if(Async* selected  = select_if_either_has_type(left, right, type))
+            return selected;
+    }
+
+    return nullptr;
+}
+
+// Concatenate the values of Value Asyncs,
+// moving them out of sources that are not shared.
+template<class Sources>
+static
+DestructibleTuple
+concat_values(
+        Destructible_Vtable const*  vtable,
+        Sources const&              sources)
+{
+    size_t size = 0;
+    for (Async* source : sources)
+    {
+        assert(source->type == Async_Type::IS_VALUE);
+        size += source->as_value.size;
+    }
+
+    DestructibleTuple tuple {vtable, size};
+
+    size_t offset = 0;
+    for (Async* source : sources)
+    {
+        DestructibleTuple& input = source->as_value;
+        if (source->refcount == 1)
+            tuple.set_moved(offset, input);
+        else
+            tuple.set_copies(offset, input);
+        offset += input.size;
+    }
+
+    return tuple;
+}
+
+DestructibleTuple
+Async_Concat_values(
+        Async&  left,
+        Async&  right)
+{
+    assert(left.type   == Async_Type::IS_VALUE);
+    assert(right.type  == Async_Type::IS_VALUE);
+
+    return concat_values(
+            left.as_value.vtable,
+            std::initializer_list<Async*>{ &left, &right });
+}
+
 static
 void
 Async_Concat_eval(
         Async*  self,
-        AsyncRef& next,
-        AsyncRef& blocked)
+        Async*& next,
+        Async*& blocked)
 {
     assert(self);
     assert(self->type == Async_Type::IS_CONCAT);
 
-    auto& left  = self->as_binary.left.fold();
-    auto& right = self->as_binary.right.fold();
+    auto& left  = self->as_binary.left;
+    auto& right = self->as_binary.right;
 
-    for (Async_Type type : { Async_Type::IS_CANCEL, Async_Type::IS_ERROR })
+    if (Async* selected = Async_Concat_select(left, right))
     {
-        if(Async* selected  = select_if_either_has_type(left, right, type))
-        {
-            *self = *selected;
-            return EVAL_RETURN(nullptr, nullptr);
-        }
+        *self = *selected;
+        return EVAL_RETURN(nullptr, nullptr);
     }
 
     ENSURE_DEPENDENCY(self, left);
     ENSURE_DEPENDENCY(self, right);
 
-    assert(left->type   == Async_Type::IS_VALUE);
-    assert(right->type  == Async_Type::IS_VALUE);
-
-    assert(left->as_value.vtable == right->as_value.vtable);
-
-    auto vtable = left->as_value.vtable;
-    size_t size = left->as_value.size + right->as_value.size;
+    DestructibleTuple tuple = Async_Concat_values(*left, *right);
 
-    DestructibleTuple tuple {vtable, size};
+    self->clear();
+    self->set_to_Value(std::move(tuple));
+    return EVAL_RETURN(NULL, NULL);
+}
 
-    // move or copy the values,
-    // depending on left/right refcount
+static
+bool
+flow_stays_left(
+        Async*                  left,
+        Async_Type              decision_type,
+        Async_Flow::Direction   flow_direction)
+{
+    using Direction = Async_Flow::Direction;
 
-    size_t output_i = 0;
-    for (Async* source : { left.decay(), right.decay() })
+    switch (flow_direction)
     {
-        auto copy_or_move =
-            (source->refcount == 1)
-            ? [](DestructibleTuple& input, size_t i)
-                { return input.move_from(i); }
-            : [](DestructibleTuple& input, size_t i)
-                { return input.copy_from(i); };
-        DestructibleTuple& input = source->as_value;
-        for (size_t input_i = 0; input_i < input.size; input_i++, output_i++)
-        {
-            Destructible temp = copy_or_move(input, input_i);
-            tuple.set(output_i, std::move(temp));
-        }
+        case Direction::THEN:
+            return !Async_has_category(left, decision_type);
+        case Direction::OR:
+            return Async_has_category(left, decision_type);
+        default:
+            assert(0);
+            return true;
     }
+}
 
-    self->clear();
-    self->set_to_Value(std::move(tuple));
-    return EVAL_RETURN(NULL, NULL);
+Async*
+Async_Flow_select(
+        Async_Flow& flow)
+{
+    Async* left = flow.left.fold().decay();
+
+    if (!left->has_category(Async_Type::CATEGORY_COMPLETE))
+        return nullptr;
+
+    if (flow_stays_left(left, flow.flow_type, flow.direction))
+        return left;
+    else
+        return flow.right.fold().decay();
 }
 
 void Async_Flow_eval(
         Async*      self,
-        AsyncRef&   next,
-        AsyncRef&   blocked)
+        Async*&   next,
+        Async*&   blocked)
 {
     assert(self);
     assert(self->type == Async_Type::IS_FLOW);
 
-    using Direction = Async_Flow::Direction;
-    Async* left = self->as_flow.left.decay();
-    Async* right = self->as_flow.right.decay();
-    Async_Type decision_type = self->as_flow.flow_type;
-    Direction flow_direction = self->as_flow.direction;
+    Async* left = self->as_flow.left.fold().decay();
 
     ENSURE_DEPENDENCY(self, left);
 
-    bool stay_left;
-    switch (flow_direction)
+    Async* selected = Async_Flow_select(self->as_flow);
+    assert(selected);
+
+    EVAL_RETURN_RESULT(self, selected);
+}
+
+static
+void
+Async_Seq_eval(
+        Async*      self,
+        Async*&   next,
+        Async*&   blocked)
+{
+    assert(self);
+    assert(self->type == Async_Type::IS_SEQ);
+
+    Async_Seq& seq = self->as_seq;
+
+    while (seq.index + 1 < seq.steps.size())
     {
-        case Direction::THEN:
-            stay_left = !Async_has_category(left, decision_type);
-            break;
-        case Direction::OR:
-            stay_left = Async_has_category(left, decision_type);
-            break;
+        Async* current = seq.steps[seq.index].fold().decay();
+
+        ENSURE_DEPENDENCY(self, current);
+
+        if (flow_stays_left(current, seq.flow_type, seq.direction))
+            EVAL_RETURN_RESULT(self, current);
+
+        // release finished steps early
+        seq.steps[seq.index].clear();
+        seq.index++;
+    }
+
+    AsyncRef last = std::move(seq.steps[seq.index]);
+    EVAL_RETURN_RESULT(self, last);
+}
+
+static
+bool
+select_decides(
+        Async&              input,
+        Async_Select::Mode  mode)
+{
+    switch (mode)
+    {
+        case Async_Select::ALL:
+            return !input.has_type(Async_Type::IS_VALUE);
+        case Async_Select::ANY:
+            return input.has_type(Async_Type::IS_VALUE);
+        case Async_Select::RACE:
+            return true;
         default:
             assert(0);
+            return true;
     }
+}
 
-    if (stay_left)
+// Whether nothing but the Select uses an incomplete input,
+// so that cancelling it can't be observed anywhere else.
+// Inputs that the Select started in this run are also held by the run loop,
+// in the queue or as a waiter of their dependency.
+// Other runs may hold more references, so they are not counted.
+static
+bool
+is_select_only_user(
+        Async const&    input,
+        bool            started_in_this_run)
+{
+    size_t const run_loop_refs = started_in_this_run ? 1 : 0;
+    return input.refcount <= 1 + run_loop_refs;
+}
+
+// Decide the outcome once all inputs are complete.
+// Only for outcomes that no single input decided.
+static
+void
+select_complete_undecided(
+        Async&                  self,
+        std::vector<AsyncRef>&  inputs,
+        Async_Select::Mode      mode)
+{
+    switch (mode)
     {
-        *self = *left;
-        return EVAL_RETURN(NULL, NULL);
+        case Async_Select::ALL:
+        {
+            std::vector<Async*> sources{};
+            sources.reserve(inputs.size());
+            for (AsyncRef& input : inputs)
+                sources.push_back(&input->ptr_follow());
+
+            DestructibleTuple tuple = concat_values(
+                    sources.front()->as_value.vtable, sources);
+
+            self.clear();
+            self.set_to_Value(std::move(tuple));
+            return;
+        }
+        case Async_Select::ANY:
+        {
+            for (AsyncRef& input : inputs)
+            {
+                if (input->has_type(Async_Type::IS_ERROR))
+                {
+                    self = input.get();
+                    return;
+                }
+            }
+
+            self.clear();
+            self.set_to_Cancel();
+            return;
+        }
+        default:
+            assert(0);
     }
+}
+
+static
+void
+Async_Select_eval(
+        Async*      self,
+        Async*&   next,
+        Async*&   blocked)
+{
+    assert(self);
+    assert(self->type == Async_Type::IS_SELECT);
+
+    Async_Select& select = self->as_select;
+
+    Async* winner = nullptr;
+    Async* first_incomplete = nullptr;
+    for (AsyncRef& input : select.inputs)
+    {
+        Async* current = input.fold().decay();
+
+        if (!current->has_category(Async_Type::CATEGORY_COMPLETE))
+        {
+            if (!first_incomplete)
+                first_incomplete = current;
+            continue;
+        }
+
+        if (select_decides(*current, select.mode))
+        {
+            winner = current;
+            break;
+        }
+    }
+
+    if (!winner && first_incomplete)
+    {
+        if (select.started_in_run == active_run)
+            return EVAL_RETURN(nullptr, self);
+
+        // Start all incomplete inputs at once.
+        // We continue with the first one, the others are queued.
+        assert(active_scheduler);
+        select.started_in_run = active_run;
+        for (AsyncRef& input : select.inputs)
+        {
+            if (input.decay() == first_incomplete)
+                continue;
+            if (input->has_category(Async_Type::CATEGORY_COMPLETE))
+                continue;
+            active_scheduler->block_on(input.get(), AsyncRef{self});
+            active_scheduler->enqueue(AsyncRef{input});
+        }
+        return EVAL_RETURN(first_incomplete, self);
+    }
+
+    // Keep the inputs alive until the losers are cancelled.
+    Async_Select::Mode mode = select.mode;
+    bool const started_in_this_run = select.started_in_run == active_run;
+    std::vector<AsyncRef> inputs = std::move(select.inputs);
+
+    if (winner)
+        *self = *winner;
     else
+        select_complete_undecided(*self, inputs, mode);
+
+    // Losers that are used elsewhere must still complete,
+    // so we only drop our reference to them.
+    for (AsyncRef& input : inputs)
     {
-        *self = *right;
-        return EVAL_RETURN(self, NULL);
+        Async& loser = *input.fold();
+        if (loser.has_category(Async_Type::CATEGORY_COMPLETE))
+            continue;
+        if (is_select_only_user(loser, started_in_this_run))
+            Async_cancel(loser);
     }
+
+    return EVAL_RETURN(nullptr, nullptr);
 }
 
 // Polymorphic
@@ -255,15 +685,27 @@ void Async_Flow_eval(
 void
 Async_eval(
         Async*  self,
-        AsyncRef& next,
-        AsyncRef& blocked)
+        Async*& next,
+        Async*& blocked)
 {
+    Async_stats.eval_steps++;
+
     ASYNC_LOG_DEBUG(
             "running Async %p (%2d %s)\n",
             self,
             static_cast<int>(self->type),
             Async_Type_name(self->type));
 
+    // pending work created after its scope was cancelled
+    if (self->scope && self->scope->is_cancelled()
+            && self->type != Async_Type::IS_PTR
+            && !self->has_category(Async_Type::CATEGORY_COMPLETE))
+    {
+        self->clear();
+        self->set_to_Cancel();
+        return EVAL_RETURN(nullptr, nullptr);
+    }
+
     switch (self->type) {
         case Async_Type::IS_UNINITIALIZED:
             assert(0);
@@ -283,6 +725,9 @@ Async_eval(
             Async_Thunk_eval(
                     self, next, blocked);
             break;
+        case Async_Type::IS_LOOP:
+            Async_Loop_eval(self, next, blocked);
+            break;
         case Async_Type::IS_CONCAT:
             Async_Concat_eval(
                     self, next, blocked);
@@ -290,6 +735,12 @@ Async_eval(
         case Async_Type::IS_FLOW:
             Async_Flow_eval(self, next, blocked);
             break;
+        case Async_Type::IS_SEQ:
+            Async_Seq_eval(self, next, blocked);
+            break;
+        case Async_Type::IS_SELECT:
+            Async_Select_eval(self, next, blocked);
+            break;
 
         case Async_Type::CATEGORY_COMPLETE:
             assert(0);
@@ -315,6 +766,6 @@ Async_eval(
     ASYNC_LOG_DEBUG(
             "... %p result: next=%p blocked=%p\n",
             self,
-            next.decay(),
-            blocked.decay());
+            next,
+            blocked);
 }
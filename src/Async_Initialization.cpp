@@ -5,10 +5,6 @@
 
 #define UNUSED(x) (void)(x)
 
-#define BINARY_INIT(name, type)                                             \
-    void Async::set_to_ ## name (AsyncRef left, AsyncRef right)             \
-    { set_to_Binary(*this, type, std::move(left), std::move(right)); }
-
 #define ASSERT_INIT(self) do {                                              \
     assert((self)->type == Async_Type::IS_UNINITIALIZED);                   \
 } while (0)
@@ -18,8 +14,11 @@ static void set_to_Binary(Async& self, Async_Type, AsyncRef, AsyncRef);
 static void Async_Ptr_clear        (Async* self);
 static void Async_RawThunk_clear   (Async* self);
 static void Async_Thunk_clear      (Async* self);
+static void Async_Loop_clear       (Async& self);
 static void Async_Binary_clear     (Async& self, Async_Type type);
 static void Async_Flow_clear       (Async& self);
+static void Async_Seq_clear        (Async& self);
+static void Async_Select_clear     (Async& self);
 static void Async_Cancel_clear     (Async* self);
 static void Async_Error_clear      (Async* self);
 static void Async_Value_clear      (Async* self);
@@ -47,12 +46,21 @@ auto Async::clear() -> void
         case Async_Type::IS_THUNK:
             Async_Thunk_clear(this);
             break;
+        case Async_Type::IS_LOOP:
+            Async_Loop_clear(*this);
+            break;
         case Async_Type::IS_CONCAT:
             Async_Binary_clear(*this, type);
             break;
         case Async_Type::IS_FLOW:
             Async_Flow_clear(*this);
             break;
+        case Async_Type::IS_SEQ:
+            Async_Seq_clear(*this);
+            break;
+        case Async_Type::IS_SELECT:
+            Async_Select_clear(*this);
+            break;
 
         case Async_Type::CATEGORY_COMPLETE:
             assert(0);
@@ -95,7 +103,10 @@ auto Async::set_from(Async&& other) -> void
             Async_Ptr_clear(&other);
             break;
         case Async_Type::IS_RAWTHUNK:
-            assert(0); // TODO not implemented
+            set_to_RawThunk(
+                    std::move(other.as_rawthunk.callback),
+                    std::move(other.as_rawthunk.dependency));
+            Async_RawThunk_clear(&other);
             break;
         case Async_Type::IS_THUNK:
             set_to_Thunk(
@@ -103,6 +114,10 @@ auto Async::set_from(Async&& other) -> void
                     std::move(other.as_thunk.dependency));
             Async_Thunk_clear(&other);
             break;
+        case Async_Type::IS_LOOP:
+            set_to_Loop(std::move(other.as_loop.callback));
+            Async_Loop_clear(other);
+            break;
         case Async_Type::IS_CONCAT:
             set_to_Binary(
                     *this,
@@ -115,6 +130,14 @@ auto Async::set_from(Async&& other) -> void
             set_to_Flow(std::move(other.as_flow));
             Async_Flow_clear(other);
             break;
+        case Async_Type::IS_SEQ:
+            set_to_Seq(std::move(other.as_seq));
+            Async_Seq_clear(other);
+            break;
+        case Async_Type::IS_SELECT:
+            set_to_Select(std::move(other.as_select));
+            Async_Select_clear(other);
+            break;
 
         case Async_Type::CATEGORY_COMPLETE:
             assert(0);
@@ -156,6 +179,43 @@ auto Async::operator=(Async& other) -> Async&
         return *this;
     }
 
+    // likewise for a Value without values
+    if (other.has_type(Async_Type::IS_VALUE)
+            && other.ptr_follow().as_value.size == 0)
+    {
+        auto vtable = other.ptr_follow().as_value.vtable;
+        clear();
+        set_to_Value(DestructibleTuple{vtable, 0});
+        return *this;
+    }
+
+    Async& target = other.ptr_follow();
+
+    // A shared computation that is still incomplete is taken over,
+    // and a Ptr to us is left behind.
+    // Otherwise, a tail-recursive loop with shared results
+    // would grow a Ptr chain with one node per iteration.
+    if (target.refcount > 1
+            && !target.has_category(Async_Type::CATEGORY_COMPLETE)
+            && &target != this)
+    {
+        AsyncRef keep{&target};  // keep ref in case we own it
+        clear();
+
+        Async_Blocked target_blocked{};
+        noexcept_swap(target_blocked, target.blocked);
+        set_from(std::move(target));
+        for (auto& ref : target_blocked)
+            blocked.emplace_back(std::move(ref));
+
+        // the pending work stays cancellable with its scope
+        if (target.scope)
+            set_scope(target.scope);
+
+        target.set_to_Ptr(this);
+        return *this;
+    }
+
     if (other.refcount > 1)
     {
         AsyncRef ref{&other};  // keep ref in case we own it
@@ -173,6 +233,9 @@ auto Async::operator=(Async& other) -> Async&
 
     clear();
 
+    if (other.scope && !other.has_category(Async_Type::CATEGORY_COMPLETE))
+        set_scope(other.scope);
+
     set_from(std::move(other));
     return *this;
 }
@@ -225,9 +288,19 @@ void Async::set_to_RawThunk(
     ASSERT_INIT(this);
     assert(callback);
 
-    UNUSED(dependency);
+    if (dependency)
+        dependency.fold();
 
-    assert(0); // TODO not implemented
+    ASYNC_LOG_DEBUG(
+            "init %p to RawThunk: callback=??? dependency=" ASYNC_FORMAT "\n",
+            this,
+            ASYNC_FORMAT_ARGS(dependency.decay()));
+
+    type = Async_Type::IS_RAWTHUNK;
+    new (&as_rawthunk) Async_RawThunk{
+        std::move(callback),
+        std::move(dependency),
+    };
 }
 
 void
@@ -237,7 +310,13 @@ Async_RawThunk_clear(
     assert(self);
     assert(self->type == Async_Type::IS_RAWTHUNK);
 
-    assert(0);  // TODO not implemented
+    ASYNC_LOG_DEBUG(
+            "clear %p of RawThunk: callback=??? dependency=" ASYNC_FORMAT "\n",
+            self,
+            ASYNC_FORMAT_ARGS(self->as_rawthunk.dependency.decay()));
+
+    self->type = Async_Type::IS_UNINITIALIZED;
+    self->as_rawthunk.~Async_RawThunk();
 }
 
 // Thunk
@@ -280,6 +359,29 @@ Async_Thunk_clear(
     self->as_thunk.~Async_Thunk();
 }
 
+// Loop
+
+void Async::set_to_Loop(Async_Loop::Callback callback)
+{
+    ASSERT_INIT(this);
+    assert(callback);
+
+    ASYNC_LOG_DEBUG("init %p to Loop: callback=???\n", this);
+
+    type = Async_Type::IS_LOOP;
+    new (&as_loop) Async_Loop{ std::move(callback) };
+}
+
+static void Async_Loop_clear(Async& self)
+{
+    assert(self.type == Async_Type::IS_LOOP);
+
+    ASYNC_LOG_DEBUG("clear %p of Loop: callback=???\n", &self);
+
+    self.type = Async_Type::IS_UNINITIALIZED;
+    self.as_loop.~Async_Loop();
+}
+
 // Binary
 
 static void set_to_Binary(
@@ -330,7 +432,28 @@ static void Async_Binary_clear(
     self.as_binary.~Async_Pair();
 }
 
-BINARY_INIT(Concat,     Async_Type::IS_CONCAT)
+// Concat
+
+void Async::set_to_Concat(AsyncRef left, AsyncRef right)
+{
+    set_to_Binary(*this, Async_Type::IS_CONCAT, std::move(left), std::move(right));
+
+    // fold right away if the outcome is already known
+    auto& pair = as_binary;
+    if (Async* selected = Async_Concat_select(pair.left, pair.right))
+    {
+        *this = *selected;
+        return;
+    }
+
+    if (pair.left->has_category(Async_Type::CATEGORY_COMPLETE)
+            && pair.right->has_category(Async_Type::CATEGORY_COMPLETE))
+    {
+        DestructibleTuple values = Async_Concat_values(*pair.left, *pair.right);
+        clear();
+        set_to_Value(std::move(values));
+    }
+}
 
 // Flow
 
@@ -359,6 +482,10 @@ void Async::set_to_Flow(Async_Flow flow)
 
     type = Async_Type::IS_FLOW;
     new (&as_flow) Async_Flow( std::move(flow) );
+
+    // fold right away if the outcome is already known
+    if (Async* selected = Async_Flow_select(as_flow))
+        *this = *selected;
 }
 
 static void Async_Flow_clear(Async& self)
@@ -383,6 +510,106 @@ static void Async_Flow_clear(Async& self)
     self.as_flow.~Async_Flow();
 }
 
+// Seq
+
+void Async::set_to_Seq(Async_Seq seq)
+{
+    ASSERT_INIT(this);
+    assert(seq.index < seq.steps.size());
+
+    ASYNC_LOG_DEBUG(
+            "init %p to Seq: steps=%zu index=%zu decision=%s flow=%s\n",
+            this,
+            seq.steps.size(),
+            seq.index,
+            Async_Type_name(seq.flow_type),
+            (seq.direction == Async_Flow::THEN)         ? "THEN"
+                : (seq.direction == Async_Flow::OR)     ? "OR"
+                : "(unknown)");
+
+    type = Async_Type::IS_SEQ;
+    new (&as_seq) Async_Seq( std::move(seq) );
+}
+
+static void Async_Seq_clear(Async& self)
+{
+    assert(self.type == Async_Type::IS_SEQ);
+
+    ASYNC_LOG_DEBUG(
+            "clear %p from Seq: steps=%zu index=%zu\n",
+            &self,
+            self.as_seq.steps.size(),
+            self.as_seq.index);
+
+    self.type = Async_Type::IS_UNINITIALIZED;
+    self.as_seq.~Async_Seq();
+}
+
+bool
+Async_Seq_try_append(
+        Async&                  self,
+        AsyncRef                step,
+        Async_Type              flow_type,
+        Async_Flow::Direction   direction)
+{
+    assert(step);
+
+    if (self.type == Async_Type::IS_FLOW
+            && self.as_flow.flow_type == flow_type
+            && self.as_flow.direction == direction)
+    {
+        std::vector<AsyncRef> steps{};
+        steps.reserve(4);
+        steps.emplace_back(std::move(self.as_flow.left));
+        steps.emplace_back(std::move(self.as_flow.right));
+
+        self.clear();
+        self.set_to_Seq({ std::move(steps), 0, flow_type, direction });
+    }
+
+    if (self.type != Async_Type::IS_SEQ
+            || self.as_seq.flow_type != flow_type
+            || self.as_seq.direction != direction)
+        return false;
+
+    step.fold();
+    self.as_seq.steps.emplace_back(std::move(step));
+    return true;
+}
+
+// Select
+
+void Async::set_to_Select(Async_Select select)
+{
+    ASSERT_INIT(this);
+    assert(select.inputs.size() > 0);
+
+    ASYNC_LOG_DEBUG(
+            "init %p to Select: inputs=%zu mode=%s\n",
+            this,
+            select.inputs.size(),
+            (select.mode == Async_Select::ALL)          ? "ALL"
+                : (select.mode == Async_Select::ANY)    ? "ANY"
+                : (select.mode == Async_Select::RACE)   ? "RACE"
+                : "(unknown)");
+
+    type = Async_Type::IS_SELECT;
+    new (&as_select) Async_Select( std::move(select) );
+}
+
+static void Async_Select_clear(Async& self)
+{
+    assert(self.type == Async_Type::IS_SELECT);
+
+    ASYNC_LOG_DEBUG(
+            "clear %p from Select: inputs=%zu\n",
+            &self,
+            self.as_select.inputs.size());
+
+    self.type = Async_Type::IS_UNINITIALIZED;
+    self.as_select.~Async_Select();
+}
+
 // Cancel
 
 void Async::set_to_Cancel()
@@ -11,7 +11,12 @@ class CircularBuffer
     size_t m_size;
     size_t m_start;
 
-    size_t map_index(size_t i) const { return (m_start + i) % capacity(); }
+    // i < capacity(), so a single wraparound suffices
+    size_t map_index(size_t i) const
+    {
+        size_t j = m_start + i;
+        return (j >= capacity()) ? j - capacity() : j;
+    }
 
     size_t next_capacity() const
     {
@@ -0,0 +1,76 @@
+#pragma once
+
+// requires the Perl headers
+
+#define ASYNC_CLASS "Async::Trampoline"
+#define ASYNC_CONTINUE_CLASS "Async::Trampoline::Continue"
+#define ASYNC_SCOPE_CLASS "Async::Trampoline::Scope"
+#define ASYNC_SCHEDULER_CLASS "Async::Trampoline::Scheduler"
+
+/** The stashes of the classes that wrap our objects.
+ *
+ *  They are looked up once per interpreter,
+ *  so that checking the class of an object is a pointer comparison
+ *  instead of comparing class names.
+ *  A reference is held, so that the pointers stay valid.
+ *
+ *  Each XS module keeps them in its MY_CXT
+ *  and provides class_stashes(aTHX) for the typemap.
+ */
+struct Async_Class_Stashes {
+    HV* async_stash;
+    HV* continue_stash;
+    HV* scope_stash;
+    HV* scheduler_stash;
+};
+
+/** Look up the class stashes for the current interpreter.
+ *
+ *  Call this from BOOT, and from CLONE for new threads.
+ */
+static void lookup_class_stashes(pTHX_ Async_Class_Stashes& classes)
+{
+    classes.async_stash = (HV*) SvREFCNT_inc_simple_NN(
+            gv_stashpvs(ASYNC_CLASS, GV_ADD));
+    classes.continue_stash = (HV*) SvREFCNT_inc_simple_NN(
+            gv_stashpvs(ASYNC_CONTINUE_CLASS, GV_ADD));
+    classes.scope_stash = (HV*) SvREFCNT_inc_simple_NN(
+            gv_stashpvs(ASYNC_SCOPE_CLASS, GV_ADD));
+    classes.scheduler_stash = (HV*) SvREFCNT_inc_simple_NN(
+            gv_stashpvs(ASYNC_SCHEDULER_CLASS, GV_ADD));
+}
+
+/** Whether an SV is a reference to an object blessed into the stash.
+ *
+ *  Like sv_isa(), subclasses don't match.
+ */
+static inline bool sv_isa_stash(SV* sv, HV* stash)
+{
+    return SvROK(sv) && SvOBJECT(SvRV(sv)) && SvSTASH(SvRV(sv)) == stash;
+}
+
+/** Get the pointer of an object created by sv_setref_stash().
+ *
+ *  The class must have been checked with sv_isa_stash().
+ */
+template<class T>
+static inline T* sv_ref_pointer(SV* sv)
+{
+    return INT2PTR(T*, SvIVX(SvRV(sv)));
+}
+
+/** Like sv_setref_pv(), but with a stash instead of a class name.
+ */
+static inline SV* sv_setref_stash(pTHX_ SV* rv, HV* stash, void* pv)
+{
+    if (!pv)
+    {
+        sv_setsv(rv, &PL_sv_undef);
+        SvSETMAGIC(rv);
+        return rv;
+    }
+
+    sv_setiv(newSVrv(rv, nullptr), PTR2IV(pv));
+    sv_bless(rv, stash);
+    return rv;
+}
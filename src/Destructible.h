@@ -41,106 +41,142 @@ struct Destructible_Vtable {
     }
 };
 
-struct Destructible {
+/** The default value policy: every operation goes through the vtable.
+ *
+ *  A value policy implements copying and destroying of the values
+ *  held by Destructible and DestructibleTuple.
+ *  Specialized policies can handle well-known vtables inline,
+ *  but must fall back to the vtable for any other vtable.
+ */
+struct Destructible_Vtable_Policy {
+    static auto copy(Destructible_Vtable const* vtable, void* data) -> void*
+    { return vtable->copy(data); }
+
+    static auto destroy(Destructible_Vtable const* vtable, void* data) -> void
+    { vtable->destroy(data); }
+
+    static auto copy_n(
+            Destructible_Vtable const* vtable,
+            void* const* source,
+            void** dest,
+            size_t n) -> void
+    {
+        for (size_t i = 0; i < n; i++)
+            dest[i] = vtable->copy(source[i]);
+    }
+
+    static auto destroy_n(
+            Destructible_Vtable const* vtable,
+            void** data,
+            size_t n) -> void
+    {
+        for (size_t i = 0; i < n; i++)
+            vtable->destroy(data[i]);
+    }
+};
+
+template<class Policy>
+struct BasicDestructible {
     void*                       data;
     Destructible_Vtable const*  vtable;
 
-    Destructible(void* data, Destructible_Vtable const* vtable) :
+    BasicDestructible(void* data, Destructible_Vtable const* vtable) :
         data{data}, vtable{vtable}
     {
         assert(data);
         assert(vtable);
     }
 
-    Destructible(Destructible&& other) noexcept :
+    BasicDestructible(BasicDestructible&& other) noexcept :
         data{nullptr}, vtable{nullptr}
     { noexcept_swap(*this, other); }
 
-    Destructible(Destructible const& other) :
-        Destructible{other.vtable->copy(other.data), other.vtable}
+    BasicDestructible(BasicDestructible const& other) :
+        BasicDestructible{Policy::copy(other.vtable, other.data), other.vtable}
     {}
 
     auto clear() -> void
     {
         if (vtable)
-            vtable->destroy(data);
+            Policy::destroy(vtable, data);
         data = nullptr;
         vtable = nullptr;
     }
 
-    ~Destructible()
+    ~BasicDestructible()
     {
         clear();
     }
 
-    friend auto swap(Destructible& lhs, Destructible& rhs) noexcept -> void
+    friend auto swap(BasicDestructible& lhs, BasicDestructible& rhs) noexcept
+        -> void
     {
         noexcept_member_swap(lhs, rhs,
-                &Destructible::data,
-                &Destructible::vtable);
+                &BasicDestructible::data,
+                &BasicDestructible::vtable);
     }
 
-    auto operator= (Destructible other) -> Destructible&
+    auto operator= (BasicDestructible other) -> BasicDestructible&
     {
         swap(*this, other);
         return *this;
     }
 };
 
-struct DestructibleTuple {
+template<class Policy>
+struct BasicDestructibleTuple {
     Destructible_Vtable const* vtable;
     size_t size;
     std::unique_ptr<void*[]> data;
 
-    DestructibleTuple() :
+    BasicDestructibleTuple() :
         vtable{nullptr}, size{0}, data{nullptr}
     {}
 
-    DestructibleTuple(Destructible_Vtable const* vtable, size_t size) :
+    BasicDestructibleTuple(Destructible_Vtable const* vtable, size_t size) :
         vtable{vtable},
         size{size},
-        data{new void*[size]}
+        data{size ? new void*[size] : nullptr}
     {
         assert(vtable);
         for (size_t i = 0; i < size; i++)
             data[i] = nullptr;
     }
 
-    DestructibleTuple(DestructibleTuple const& other) :
-        DestructibleTuple{other.vtable, other.size}
+    BasicDestructibleTuple(BasicDestructibleTuple const& other) :
+        BasicDestructibleTuple{other.vtable, other.size}
     {
-        for (size_t i = 0; i < size; i++)
-            data[i] = vtable->copy(other.data[i]);
+        if (size)
+            Policy::copy_n(vtable, other.begin(), begin(), size);
     }
 
-    DestructibleTuple(DestructibleTuple&& other) noexcept :
-        DestructibleTuple{}
+    BasicDestructibleTuple(BasicDestructibleTuple&& other) noexcept :
+        BasicDestructibleTuple{}
     { noexcept_swap(*this, other); }
 
-    ~DestructibleTuple()
+    ~BasicDestructibleTuple()
     {
-        for (size_t i = 0; i < size; i++)
-        {
-            vtable->destroy(data[i]);
-            data[i] = nullptr;
-        }
+        if (size)
+            Policy::destroy_n(vtable, begin(), size);
     }
 
-    friend void swap(DestructibleTuple& lhs, DestructibleTuple& rhs) noexcept
+    friend void swap(
+            BasicDestructibleTuple& lhs, BasicDestructibleTuple& rhs) noexcept
     {
         noexcept_member_swap(lhs, rhs,
-                &DestructibleTuple::vtable,
-                &DestructibleTuple::size,
-                &DestructibleTuple::data);
+                &BasicDestructibleTuple::vtable,
+                &BasicDestructibleTuple::size,
+                &BasicDestructibleTuple::data);
     }
 
-    auto operator=(DestructibleTuple other) noexcept -> DestructibleTuple&
+    auto operator=(BasicDestructibleTuple other) noexcept
+        -> BasicDestructibleTuple&
     { noexcept_swap(*this, other); return *this; }
 
-    auto begin()        -> void**       { return &data[0]; }
-    auto begin() const  -> void* const* { return &data[0]; }
-    auto end()          -> void**       { return &data[size]; }
-    auto end() const    -> void* const* { return &data[size]; }
+    auto begin()        -> void**       { return data.get(); }
+    auto begin() const  -> void* const* { return data.get(); }
+    auto end()          -> void**       { return data.get() + size; }
+    auto end() const    -> void* const* { return data.get() + size; }
 
     auto at(size_t i) const -> void*
     {
@@ -148,18 +184,31 @@ struct DestructibleTuple {
         return data[i];
     }
 
-    auto copy_from(size_t i) const -> Destructible
-    { return { vtable->copy(at(i)), vtable }; }
+    auto copy_from(size_t i) const -> BasicDestructible<Policy>
+    { return { Policy::copy(vtable, at(i)), vtable }; }
 
-    auto move_from(size_t i) -> Destructible
+    auto move_from(size_t i) -> BasicDestructible<Policy>
     {
         assert(i < size);
-        Destructible result { data[i], vtable };
+        BasicDestructible<Policy> result { data[i], vtable };
         data[i] = nullptr;
         return result;
     }
 
-    auto set(size_t i, Destructible source) -> void
+    /** Take a value out of the tuple without destroying it.
+     *
+     *  The caller becomes responsible for the value,
+     *  the slot is left empty.
+     */
+    auto release(size_t i) -> void*
+    {
+        assert(i < size);
+        void* value = data[i];
+        data[i] = nullptr;
+        return value;
+    }
+
+    auto set(size_t i, BasicDestructible<Policy> source) -> void
     {
         assert(vtable == source.vtable);
         assert(i < size);
@@ -168,4 +217,33 @@ struct DestructibleTuple {
         noexcept_swap(data[i], source.data);
         source.vtable = nullptr;  // to avoid empty dtor from running
     }
+
+    /** Fill the slots from "offset" on with copies of all "source" values.
+     */
+    auto set_copies(size_t offset, BasicDestructibleTuple const& source)
+        -> void
+    {
+        assert(vtable == source.vtable || source.size == 0);
+        assert(offset + source.size <= size);
+
+        if (source.size)
+            Policy::copy_n(
+                    vtable, source.begin(), begin() + offset, source.size);
+    }
+
+    /** Fill the slots from "offset" on with all "source" values,
+     *  leaving the source slots empty.
+     */
+    auto set_moved(size_t offset, BasicDestructibleTuple& source) -> void
+    {
+        assert(vtable == source.vtable || source.size == 0);
+        assert(offset + source.size <= size);
+
+        for (size_t i = 0; i < source.size; i++)
+        {
+            assert(data[offset + i] == nullptr);
+            data[offset + i] = source.data[i];
+            source.data[i] = nullptr;
+        }
+    }
 };
@@ -1,12 +1,42 @@
 #pragma once
 
 #include "Async.h"
+#include "CircularBuffer.h"
 
-#include <memory>
+#include <unordered_set>
 
+#ifndef ASYNC_TRAMPOLINE_SCHEDULER_DEBUG
+#define ASYNC_TRAMPOLINE_SCHEDULER_DEBUG 0
+#define SCHEDULER_LOG_DEBUG(...) do { } while (0)
+#else
+#include <cstdio>
+#define ASYNC_TRAMPOLINE_SCHEDULER_DEBUG 1
+#define SCHEDULER_LOG_DEBUG(...) do {                                       \
+    fprintf(stderr, "#DEBUG " __VA_ARGS__);                                 \
+    fflush(stderr);                                                         \
+} while (0)
+#endif
+
+#define SCHEDULER_RUNNABLE_QUEUE_FORMAT                                     \
+    "Scheduler { "                                                          \
+        "queue={ start=%zu size=%ld storage.size=%ld } "                    \
+        "runnable_enqueued=%zu "                                            \
+    "}"
+
+#define SCHEDULER_RUNNABLE_QUEUE_FORMAT_ARGS(self)                          \
+    (self).runnable_queue._internal_start(),                                \
+    (self).runnable_queue.size(),                                           \
+    (self).runnable_queue.capacity(),                                       \
+    (self).runnable_enqueued.size()
+
+/** The run queue.
+ *
+ *  The per-step operations are defined inline,
+ *  so that they can be inlined into the run loop.
+ */
 class Async_Trampoline_Scheduler {
-    class Impl;
-    std::unique_ptr<Impl> m_impl;
+    CircularBuffer<AsyncRef> runnable_queue{};
+    std::unordered_set<Async const*> runnable_enqueued{};
 
 public:
 
@@ -23,14 +53,15 @@ public:
      *  Returns: size_t
      *      the number of enqueued elements.
      */
-    auto queue_size() const -> size_t;
+    auto queue_size() const -> size_t { return runnable_queue.size(); }
 
     /** Enqueue an item as possibly runnable.
      *
-     *  async: AsyncRef
+     *  async: AsyncRef&&
      *      should be run in the future.
+     *      The queue takes over this reference.
      */
-    auto enqueue(AsyncRef async) -> void;
+    inline auto enqueue(AsyncRef&& async) -> void;
 
     /** Dequeue the next item.
      *
@@ -42,7 +73,7 @@ public:
      *  Returns: AsyncRef
      *      The next item.
      */
-    auto dequeue() -> AsyncRef;
+    inline auto dequeue() -> AsyncRef;
 
     /** Register a dependency relationship.
      *
@@ -52,10 +83,12 @@ public:
      *
      *  dependency_async: Async&
      *      must be completed first.
-     *  blocked_async: AsyncRef
-     *      is blocked until the "dependency_async" is completed-
+     *  blocked_async: AsyncRef&&
+     *      is blocked until the "dependency_async" is completed.
+     *      The dependency takes over this reference.
      */
-    auto block_on(Async& dependency_async, AsyncRef blocked_async) -> void;
+    inline auto block_on(Async& dependency_async, AsyncRef&& blocked_async)
+        -> void;
 
     /** Mark an item as completed.
      *
@@ -65,5 +98,78 @@ public:
      *  async: Async&
      *      a completed item.
      */
-    auto complete(Async& async) -> void;
+    inline auto complete(Async& async) -> void;
 };
+
+auto Async_Trampoline_Scheduler::enqueue(AsyncRef&& async) -> void
+{
+    // Forward a Ptr to its concrete target.
+    // Waiters are registered on the target anyway,
+    // unless they were already blocked on the Ptr before it was forwarded.
+    if (async->type == Async_Type::IS_PTR && async->blocked.empty())
+        async.fold();
+
+    SCHEDULER_LOG_DEBUG(
+            "enqueueing %p into " SCHEDULER_RUNNABLE_QUEUE_FORMAT ": "
+            ASYNC_FORMAT "\n",
+            async.decay(),
+            SCHEDULER_RUNNABLE_QUEUE_FORMAT_ARGS(*this),
+            ASYNC_FORMAT_ARGS(async.decay()));
+
+    if (!runnable_enqueued.insert(async.decay()).second)
+    {
+        SCHEDULER_LOG_DEBUG("enqueuing skipped because already in queue\n");
+        return;
+    }
+
+    runnable_queue.enq(std::move(async));
+
+    SCHEDULER_LOG_DEBUG(
+            "    '-> " SCHEDULER_RUNNABLE_QUEUE_FORMAT "\n",
+            SCHEDULER_RUNNABLE_QUEUE_FORMAT_ARGS(*this));
+}
+
+auto Async_Trampoline_Scheduler::dequeue() -> AsyncRef
+{
+    assert(runnable_queue.size());
+
+    AsyncRef async = runnable_queue.deq();
+
+    SCHEDULER_LOG_DEBUG(
+            "dequeue %p from " SCHEDULER_RUNNABLE_QUEUE_FORMAT "\n",
+            async.decay(),
+            SCHEDULER_RUNNABLE_QUEUE_FORMAT_ARGS(*this));
+
+    size_t erased = runnable_enqueued.erase(async.decay());
+    assert(erased /* dequeued an entry that was not registered in the enqueued set! */);
+    static_cast<void>(erased);
+
+    return async;
+}
+
+auto Async_Trampoline_Scheduler::block_on(
+        Async& dependency_async, AsyncRef&& blocked_async) -> void
+{
+    SCHEDULER_LOG_DEBUG(
+        "dependency of " ASYNC_FORMAT " on " ASYNC_FORMAT "\n",
+        ASYNC_FORMAT_ARGS(blocked_async.decay()),
+        ASYNC_FORMAT_ARGS(&dependency_async));
+
+    dependency_async.add_blocked(std::move(blocked_async));
+}
+
+auto Async_Trampoline_Scheduler::complete(Async& async) -> void
+{
+    SCHEDULER_LOG_DEBUG("completing %p\n", &async);
+
+    SCHEDULER_LOG_DEBUG("    '-> %zu dependencies\n", async.blocked.size());
+
+    if (async.blocked.size() == 0)
+        return;
+
+    // Any waiters registered later go to the concrete target of a Ptr,
+    // so only our own waiters have to be released.
+    for (auto& ref : async.blocked)
+        enqueue(std::move(ref));
+    async.blocked.clear();
+}
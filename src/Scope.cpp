@@ -0,0 +1,106 @@
+#include "Scope.h"
+
+#include <cassert>
+#include <vector>
+
+thread_local Async_Trampoline_Scope* Async_Trampoline_Scope::current = nullptr;
+
+Async_Trampoline_Scope::Async_Trampoline_Scope(
+        Async_Trampoline_Scope* parent) :
+    refcount{1},
+    parent{parent},
+    cancelled{false},
+    members{},
+    children{}
+{
+    if (parent)
+    {
+        parent->ref();
+        parent->children.insert(this);
+    }
+}
+
+Async_Trampoline_Scope::~Async_Trampoline_Scope()
+{
+    assert(members.empty());
+    assert(children.empty());
+
+    if (parent)
+    {
+        parent->children.erase(this);
+        parent->unref();
+    }
+}
+
+auto Async_Trampoline_Scope::alloc() -> Async_Trampoline_Scope*
+{
+    auto scope = new Async_Trampoline_Scope{current};
+
+    ASYNC_LOG_DEBUG("created new Scope at %p parent=%p\n",
+            scope, scope->parent);
+
+    return scope;
+}
+
+auto Async_Trampoline_Scope::unref() -> void
+{
+    refcount--;
+
+    if (refcount)
+        return;
+
+    ASYNC_LOG_DEBUG("deleting Scope at %p\n", this);
+
+    delete this;
+}
+
+auto Async_Trampoline_Scope::cancel() -> void
+{
+    if (cancelled)
+        return;
+
+    ASYNC_LOG_DEBUG("cancelling Scope %p: %zu members, %zu children\n",
+            this, members.size(), children.size());
+
+    cancelled = true;
+
+    // Cancelling releases payloads, which may delete other members
+    // or child scopes. So take references before touching anything.
+
+    std::vector<Async_Trampoline_Scope*> nested{};
+    nested.reserve(children.size());
+    for (Async_Trampoline_Scope* child : children)
+        nested.push_back(&child->ref());
+
+    std::vector<AsyncRef> pending{};
+    for (Async* async : members)
+    {
+        // A Ptr is cancelled through its target, if that is a member.
+        if (async->type == Async_Type::IS_PTR)
+            continue;
+        if (async->has_category(Async_Type::CATEGORY_COMPLETE))
+            continue;
+        pending.emplace_back(async);
+    }
+
+    for (AsyncRef& async : pending)
+        Async_cancel(async.get());
+
+    for (Async_Trampoline_Scope* child : nested)
+    {
+        child->cancel();
+        child->unref();
+    }
+}
+
+auto Async_Trampoline_Scope::add_member(Async& async) -> void
+{
+    ref();
+    members.insert(&async);
+}
+
+auto Async_Trampoline_Scope::remove_member(Async& async) -> void
+{
+    members.erase(&async);
+    unref();
+}
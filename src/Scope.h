@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Async.h"
+
+#include <unordered_set>
+
+/** A group of Asyncs that can be cancelled together.
+ *
+ *  Every Async allocated while a scope is current becomes a member,
+ *  and callbacks of members run with their scope as the current scope.
+ *  Scopes created while another scope is current are nested in it.
+ *
+ *  Members are not owned by the scope.
+ *  The scope is kept alive by its members, child scopes,
+ *  and any other references.
+ */
+class Async_Trampoline_Scope
+{
+    size_t refcount;
+    Async_Trampoline_Scope* parent;
+    bool cancelled;
+    std::unordered_set<Async*> members;
+    std::unordered_set<Async_Trampoline_Scope*> children;
+
+    explicit Async_Trampoline_Scope(Async_Trampoline_Scope* parent);
+    ~Async_Trampoline_Scope();
+
+public:
+
+    /** The scope of newly allocated Asyncs, or nullptr.
+     *
+     *  Per thread, because each Perl thread works on its own Asyncs.
+     */
+    static thread_local Async_Trampoline_Scope* current;
+
+    /** Create a new scope nested in the current scope.
+     *
+     *  Returns: Async_Trampoline_Scope*
+     *      a new scope with a refcount of 1.
+     */
+    static auto alloc() -> Async_Trampoline_Scope*;
+
+    auto ref() noexcept -> Async_Trampoline_Scope& { refcount++; return *this; }
+    auto unref() -> void;
+
+    auto is_cancelled() const -> bool { return cancelled; }
+
+    /** Cancel all pending members, including those of nested scopes.
+     *
+     *  Pending members are set to Cancel in place,
+     *  which releases their callbacks and wakes up their waiters.
+     *  Members that are evaluated later are cancelled before they run.
+     */
+    auto cancel() -> void;
+
+    auto add_member(Async& async) -> void;
+    auto remove_member(Async& async) -> void;
+};
+
+/** Make a scope current until the end of the block. */
+class Async_Trampoline_Scope_Enter
+{
+    Async_Trampoline_Scope* const saved;
+public:
+    explicit Async_Trampoline_Scope_Enter(Async_Trampoline_Scope* scope) :
+        saved{Async_Trampoline_Scope::current}
+    { Async_Trampoline_Scope::current = scope; }
+
+    ~Async_Trampoline_Scope_Enter()
+    { Async_Trampoline_Scope::current = saved; }
+
+    Async_Trampoline_Scope_Enter(Async_Trampoline_Scope_Enter const&) = delete;
+    auto operator=(Async_Trampoline_Scope_Enter const&)
+        -> Async_Trampoline_Scope_Enter& = delete;
+};
@@ -0,0 +1,106 @@
+#include "Async.h"
+#include "SvValuePolicy.h"
+
+extern "C" {
+#define PERL_NO_GET_CONTEXT
+#include "EXTERN.h"
+#include "perl.h"
+}
+
+static void* copy_sv_ref(void* sv);
+static void destroy_sv_ref(void* sv);
+static size_t get_refcount_sv(void* sv);
+static const char* get_stringification_sv(void* sv);
+
+Destructible_Vtable const sv_vtable {
+        destroy_sv_ref,
+        copy_sv_ref,
+        get_refcount_sv,
+        get_stringification_sv,
+};
+
+static void* copy_sv_ref(void* sv)
+{
+    dTHX;
+
+    ASYNC_LOG_DEBUG("copy_sv_ref: " DESTRUCTIBLE_FORMAT "\n",
+            DESTRUCTIBLE_FORMAT_ARGS_BORROWED(&sv_vtable, sv));
+    if (sv)
+        SvREFCNT_inc((SV*) sv);
+    return sv;
+}
+
+static void destroy_sv_ref(void* sv)
+{
+    dTHX;
+
+    ASYNC_LOG_DEBUG("destroy_sv_ref: " DESTRUCTIBLE_FORMAT "\n",
+            DESTRUCTIBLE_FORMAT_ARGS_BORROWED(&sv_vtable, sv));
+    if (sv)
+        SvREFCNT_dec((SV*) sv);
+}
+
+static size_t get_refcount_sv(void* sv)
+{
+    dTHX;
+
+    assert(sv);
+    return SvREFCNT((SV*) sv);
+}
+
+static const char* get_stringification_sv(void* sv)
+{
+    dTHX;
+
+    assert(sv);
+    if (!SvOK((SV*) sv))
+        return "<undef>";
+    return SvPV_nolen((SV*) sv);
+}
+
+#if !ASYNC_TRAMPOLINE_GENERIC_VALUES
+auto Destructible_SV_Policy::copy(
+        Destructible_Vtable const* vtable, void* data) -> void*
+{
+    if (vtable != &sv_vtable)
+        return vtable->copy(data);
+
+    return SvREFCNT_inc(static_cast<SV*>(data));
+}
+
+auto Destructible_SV_Policy::destroy(
+        Destructible_Vtable const* vtable, void* data) -> void
+{
+    if (vtable != &sv_vtable)
+        return vtable->destroy(data);
+
+    dTHX;
+    SvREFCNT_dec(static_cast<SV*>(data));
+}
+
+auto Destructible_SV_Policy::copy_n(
+        Destructible_Vtable const* vtable,
+        void* const* source,
+        void** dest,
+        size_t n) -> void
+{
+    if (vtable != &sv_vtable)
+        return Destructible_Vtable_Policy::copy_n(vtable, source, dest, n);
+
+    for (size_t i = 0; i < n; i++)
+        dest[i] = SvREFCNT_inc(static_cast<SV*>(source[i]));
+}
+
+auto Destructible_SV_Policy::destroy_n(
+        Destructible_Vtable const* vtable,
+        void** data,
+        size_t n) -> void
+{
+    if (vtable != &sv_vtable)
+        return Destructible_Vtable_Policy::destroy_n(vtable, data, n);
+
+    dTHX;
+    for (size_t i = 0; i < n; i++)
+        SvREFCNT_dec(static_cast<SV*>(data[i]));
+}
+#endif
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "Destructible.h"
+
+/** The vtable for owned references to Perl scalars. */
+extern Destructible_Vtable const sv_vtable;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Destructible.h"
+
+// The value policy is fixed at compile time.
+// By default, Perl scalars are refcounted directly
+// by the Perl binding, see SvValuePolicy.cpp.
+// Compile with -DASYNC_TRAMPOLINE_GENERIC_VALUES=1
+// to dispatch all value operations through the vtable.
+
+#ifndef ASYNC_TRAMPOLINE_GENERIC_VALUES
+#define ASYNC_TRAMPOLINE_GENERIC_VALUES 0
+#endif
+
+#if ASYNC_TRAMPOLINE_GENERIC_VALUES
+using Destructible_Policy = Destructible_Vtable_Policy;
+#else
+/** Value policy that handles Perl scalars without the vtable.
+ *
+ *  Values with the sv_vtable are reference-counted directly,
+ *  so that copying and destroying a tuple is a single call
+ *  instead of one vtable call per value.
+ *  Any other vtable is dispatched as usual.
+ *
+ *  This is implemented by the Perl binding,
+ *  so that the core does not depend on the Perl headers.
+ */
+struct Destructible_SV_Policy {
+    static auto copy(Destructible_Vtable const* vtable, void* data) -> void*;
+
+    static auto destroy(Destructible_Vtable const* vtable, void* data) -> void;
+
+    static auto copy_n(
+            Destructible_Vtable const* vtable,
+            void* const* source,
+            void** dest,
+            size_t n) -> void;
+
+    static auto destroy_n(
+            Destructible_Vtable const* vtable,
+            void** data,
+            size_t n) -> void;
+};
+
+using Destructible_Policy = Destructible_SV_Policy;
+#endif
+
+using Destructible      = BasicDestructible<Destructible_Policy>;
+using DestructibleTuple = BasicDestructibleTuple<Destructible_Policy>;
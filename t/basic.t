@@ -92,6 +92,188 @@ describe q(async()) => sub {
     };
 };
 
+describe q(async_loop()) => sub {
+    it q(iterates until a result is returned) => sub {
+        my @seen;
+        my $async = async_loop 3, sub {
+            my ($i) = @_;
+            push @seen, $i;
+            return async_value "done" if not $i;
+            return async_continue $i - 1;
+        };
+        is $async->run_until_completion, "done";
+        is "@seen", "3 2 1 0";
+    };
+
+    it q(evaluates the returned Async) => sub {
+        my $async = async_loop 0, sub { async { async_value "value" } };
+        is $async->run_until_completion, "value";
+    };
+
+    it q(can be cancelled) => sub {
+        my $async = async_loop 0, sub { async_cancel };
+        $async = $async->resolved_or(async_value "fallback");
+        is $async->run_until_completion, "fallback";
+    };
+
+    it q(catches errors from the callback) => sub {
+        my $async = async_loop 0, sub { die "loop error\n" };
+        throws_ok { $async->run_until_completion } qr/\Aloop error$/;
+        ok $async->is_error;
+    };
+
+    it q(requires the callback to return an Async or async_continue()) => sub {
+        my $async = async_loop 0, sub { return "foo" };
+        throws_ok { $async->run_until_completion }
+            qr/^Async callback must return another Async!/;
+    };
+};
+
+describe q(match()) => sub {
+    my %handlers = (
+        value   => sub { async_value "value: @_" },
+        error   => sub { async_value "error: @_" },
+        cancel  => sub { async_value "cancel" },
+    );
+
+    it qq(dispatches on $_->[0]) => sub {
+        my (undef, $make, $expected) = @$_;
+        my $async = $make->()->match(%handlers);
+        is $async->run_until_completion, $expected;
+    } for
+        [value          => sub { async_value 1, 2 },        "value: 1 2"],
+        [error          => sub { async_error "oops\n" },    "error: oops\n"],
+        [cancel         => sub { async_cancel },            "cancel"],
+        [thunk          => sub { async { async_value 3 } }, "value: 3"];
+
+    it q(passes unhandled outcomes through) => sub {
+        my $async = async_error("oops\n")->match(value => sub { die });
+        throws_ok { $async->run_until_completion } qr/\Aoops$/;
+
+        $async = async_value(42)->match(error => sub { die });
+        is $async->run_until_completion, 42;
+    };
+
+    it q(catches errors from the callback) => sub {
+        my $async = async_value(1)->match(value => sub { die "callback\n" });
+        throws_ok { $async->run_until_completion } qr/\Acallback$/;
+    };
+
+    it q(validates the arguments) => sub {
+        throws_ok { async_value->match("value") }
+            qr/match\(\) expects outcome => callback pairs/;
+        throws_ok { async_value->match(foo => sub {}) }
+            qr/match\(\) outcome must be value, error, or cancel: foo/;
+        throws_ok { async_value->match(value => 1) }
+            qr/match\(\) callback must be a code ref: value/;
+        throws_ok { async_value->match(value => sub {}, value => sub {}) }
+            qr/match\(\) outcome specified twice: value/;
+    };
+};
+
+describe q(finally()) => sub {
+    it qq(runs on $_->[0] and keeps the outcome) => sub {
+        my (undef, $make, $check) = @$_;
+        my $ran = 0;
+        my $async = $make->()->finally(sub { $ran++; return "ignored" });
+        $check->($async);
+        is $ran, 1, q(callback ran once);
+    } for
+        [value  => sub { async_value 42 }, sub {
+            my ($async) = @_;
+            is $async->run_until_completion, 42;
+        }],
+        [error  => sub { async_error "oops\n" }, sub {
+            my ($async) = @_;
+            throws_ok { $async->run_until_completion } qr/\Aoops$/;
+        }],
+        [cancel => sub { async_cancel }, sub {
+            my ($async) = @_;
+            throws_ok { $async->run_until_completion } qr/cancelled/;
+        }];
+
+    it q(turns errors from the callback into an Error) => sub {
+        my $async = async_value(1)->finally(sub { die "cleanup failed\n" });
+        throws_ok { $async->run_until_completion } qr/\Acleanup failed$/;
+    };
+};
+
+describe q(async_scope()) => sub {
+    package Local::Guard {
+        sub new { my ($class, $cb) = @_; bless { cb => $cb }, $class }
+        sub DESTROY { $_[0]{cb}->() }
+    }
+
+    it q(returns the Async from the block) => sub {
+        my $async = async_scope { async_value 42 };
+        is $async->run_until_completion, 42;
+    };
+
+    it q(passes the scope to the block) => sub {
+        my $scope;
+        async_scope { ($scope) = @_; async_value };
+        isa_ok $scope, 'Async::Trampoline::Scope';
+        ok !$scope->is_cancelled, q(not cancelled yet);
+    };
+
+    it q(cancels pending Asyncs and releases their callbacks) => sub {
+        my @log;
+        my $async = async_scope {
+            my ($scope) = @_;
+            my $guard = Local::Guard->new(sub { push @log, "released" });
+            async_loop 0, sub {
+                my ($i) = @_;
+                push @log, "iteration $i" if $guard;
+                $scope->cancel if $i == 2;
+                return async_continue $i + 1;
+            };
+        };
+
+        my $result = $async->value_or(async { push @log, "fallback"; async_value "fallback" });
+        is $result->run_until_completion, "fallback";
+        is_deeply \@log, [
+            "iteration 0", "iteration 1", "iteration 2", "released", "fallback",
+        ], q(loop stopped and released its callback);
+    };
+
+    it q(cancels Asyncs created by callbacks within the scope) => sub {
+        my $ran = 0;
+        my $scope;
+        my $async = async_scope {
+            ($scope) = @_;
+            async { async { $scope->cancel; async { $ran++; async_value } } };
+        };
+        throws_ok { $async->run_until_completion } qr/cancelled/;
+        is $ran, 0, q(later callback did not run);
+    };
+
+    it q(cancels nested scopes) => sub {
+        my ($outer, $inner);
+        my $async = async_scope {
+            ($outer) = @_;
+            async_scope { ($inner) = @_; async { async_value "inner" } };
+        };
+        $outer->cancel;
+        ok $inner->is_cancelled, q(inner scope is cancelled);
+        throws_ok { $async->run_until_completion } qr/cancelled/;
+    };
+
+    it q(doesn't cancel Asyncs created outside the scope) => sub {
+        my $outside = async { async_value "outside" };
+        my $async = async_scope {
+            my ($scope) = @_;
+            $outside->value_then(async { $scope->cancel; async_value "inside" });
+        };
+        throws_ok { $async->run_until_completion } qr/cancelled/;
+        is $outside->run_until_completion, "outside";
+    };
+
+    it q(turns errors from the block into an Error) => sub {
+        my $async = async_scope { die "oops\n" };
+        throws_ok { $async->run_until_completion } qr/\Aoops$/;
+    };
+};
+
 describe q(resolved_or()) => sub {
     it q(returns the first value) => sub {
         my $async = async_value(42)->resolved_or(async_cancel);
@@ -280,6 +462,20 @@ describe q(errors) => sub {
 
         ok $async->is_error;
     };
+
+    it q(rejects arguments that are not Asyncs) => sub {
+        throws_ok { Async::Trampoline::is_value("string") }
+            qr/must be Async::Trampoline instance/;
+        throws_ok { Async::Trampoline::is_value(bless {}, "Other") }
+            qr/must be Async::Trampoline instance/;
+        throws_ok { Async::Trampoline::is_value(async_continue 1) }
+            qr/must be Async::Trampoline instance/;
+    };
+
+    it q(rejects callback results that are not Asyncs) => sub {
+        throws_ok { async { bless [], "Other" }->run_until_completion }
+            qr/must return another Async/;
+    };
 };
 
 describe q(concat()) => sub {
@@ -291,4 +487,204 @@ describe q(concat()) => sub {
     };
 };
 
+# A loop that takes $n iterations to produce $result, counting iterations.
+sub count_iterations {
+    my ($n, $counter, $result) = @_;
+    return async_loop 0, sub {
+        my ($i) = @_;
+        $$counter++;
+        return $result if $i >= $n;
+        return async_continue $i + 1;
+    };
+}
+
+describe q(async_all()) => sub {
+    it q(concatenates all values) => sub {
+        my @result = async_all(
+            async_value(1, 2), async { async_value 3 }, async_value(4),
+        )->run_until_completion;
+        is "@result", "1 2 3 4";
+    };
+
+    it q(is empty without arguments) => sub {
+        my @result = async_all()->run_until_completion;
+        is 0+@result, 0;
+    };
+
+    it qq(fails fast on $_->[0] and cancels the others) => sub {
+        my (undef, $failure, $error) = @$_;
+        my $slow = 0;
+        my $async = async_all(
+            count_iterations(1_000_000, \$slow, async_value "slow"),
+            async { $failure->() },
+        );
+        throws_ok { $async->run_until_completion } $error;
+        cmp_ok $slow, '<', 1_000, q(slow operand was stopped);
+    } for
+        [error  => sub { async_error "oops\n" }, qr/\Aoops$/],
+        [cancel => sub { async_cancel }, qr/cancelled/];
+
+    it q(dies with non-Async arguments) => sub {
+        throws_ok { async_all(async_value, 42) }
+            qr/async_all\(\) arguments must be Asyncs/;
+    };
+};
+
+describe q(async_any()) => sub {
+    it q(returns the first value) => sub {
+        my $slow = 0;
+        my $async = async_any(
+            count_iterations(1_000_000, \$slow, async_value "slow"),
+            async_error("skipped\n"),
+            async { async_value "fast" },
+        );
+        is $async->run_until_completion, "fast";
+        cmp_ok $slow, '<', 1_000, q(slow operand was stopped);
+    };
+
+    it q(returns the first error without values) => sub {
+        my $async = async_any(async_cancel, async_error("oops\n"));
+        throws_ok { $async->run_until_completion } qr/\Aoops$/;
+    };
+
+    it q(is cancelled if all operands are) => sub {
+        my $async = async_any(async_cancel, async_cancel);
+        throws_ok { $async->run_until_completion } qr/cancelled/;
+    };
+
+    it q(is cancelled without arguments) => sub {
+        throws_ok { async_any()->run_until_completion } qr/cancelled/;
+    };
+
+    it q(doesn't cancel operands that are used elsewhere) => sub {
+        my $shared = async { async_value "shared" };
+        my @result = async_all(
+            async_any(async_value("first"), $shared),
+            $shared,
+        )->run_until_completion;
+        is "@result", "first shared";
+    };
+};
+
+describe q(async_race()) => sub {
+    it q(returns the first to complete) => sub {
+        my ($slow, $fast) = (0, 0);
+        my $async = async_race(
+            count_iterations(1_000_000, \$slow, async_value "slow"),
+            count_iterations(3, \$fast, async_error "fast\n"),
+        );
+        throws_ok { $async->run_until_completion } qr/\Afast$/;
+        is $fast, 4, q(fast operand ran to completion);
+        cmp_ok $slow, '<', 1_000, q(slow operand was stopped);
+    };
+
+    it q(doesn't run operands that are already decided) => sub {
+        my $ran = 0;
+        my $async = async_race(async_value("done"), async { $ran++; async_value });
+        is $async->run_until_completion, "done";
+        is $ran, 0, q(other operand didn't run);
+    };
+
+    it q(lets operands that are used elsewhere complete) => sub {
+        my ($slow, $fast) = (0, 0);
+        my $shared = count_iterations(1_000, \$slow, async_value "slow");
+        my $async = async_race(
+            $shared,
+            count_iterations(3, \$fast, async_value "fast"),
+        );
+        is $async->run_until_completion, "fast";
+        is $shared->run_until_completion, "slow",
+            q(shared operand was not cancelled);
+        is $slow, 1_001, q(shared operand ran to completion);
+    };
+};
+
+describe q(async_value()) => sub {
+    it q(copies its arguments) => sub {
+        my $value = "original";
+        my $async = async_value $value;
+        $value = "changed";
+        is $async->run_until_completion, "original";
+    };
+
+    it q(takes over temporaries) => sub {
+        my $make = sub { return "x" x 10 };
+        my $async = async_value $make->(), "y" . "z";
+        is_deeply [$async->run_until_completion], ["x" x 10, "yz"];
+    };
+};
+
+describe q(async_value_alias()) => sub {
+    it q(refers to its arguments) => sub {
+        my $value = "original";
+        my $async = async_value_alias $value;
+        $value = "changed";
+        is $async->run_until_completion, "changed";
+    };
+
+    it q(keeps its arguments alive) => sub {
+        my $async = do { my $value = "value"; async_value_alias $value };
+        is $async->run_until_completion, "value";
+    };
+
+    it q(copies pad temporaries) => sub {
+        my @asyncs = map { async_value_alias "x$_" } 1, 2;
+        is_deeply [map { $_->run_until_completion } @asyncs], ["x1", "x2"];
+    };
+
+    it q(returns an empty Value without arguments) => sub {
+        is_deeply [async_value_alias->run_until_completion], [];
+    };
+};
+
+describe q(run_until_completion()) => sub {
+    it q(returns the values of a temporary) => sub {
+        is_deeply [async { async_value 1, 2 }->run_until_completion], [1, 2];
+    };
+
+    it q(returns the values again when run twice) => sub {
+        my $async = async { async_value 1, 2 };
+        is_deeply [$async->run_until_completion], [1, 2];
+        is_deeply [$async->run_until_completion], [1, 2];
+    };
+
+    it q(leaves shared values intact) => sub {
+        my $shared = async_value "shared";
+        is_deeply [async_value(1)->value_then($shared)->run_until_completion],
+            ["shared"];
+        is_deeply [$shared->concat($shared)->run_until_completion],
+            ["shared", "shared"];
+        is $shared->run_until_completion, "shared";
+    };
+
+    it q(returns copies that can be modified) => sub {
+        my $async = async_value "value";
+        $_ .= " modified" for $async->run_until_completion;
+        is $async->run_until_completion, "value";
+    };
+};
+
+describe q(run_until_completion_ref()) => sub {
+    it q(returns the values in an array) => sub {
+        is_deeply async { async_value 1, 2 }->run_until_completion_ref, [1, 2];
+
+        my $async = async_value 1, 2;
+        is_deeply $async->run_until_completion_ref, [1, 2];
+        is_deeply $async->run_until_completion_ref, [1, 2], q(again);
+    };
+
+    it q(returns an empty array for an empty value) => sub {
+        is_deeply async_value->run_until_completion_ref, [];
+    };
+
+    it q(rethrows errors) => sub {
+        throws_ok { async_error("oops\n")->run_until_completion_ref }
+            qr/\Aoops$/;
+    };
+
+    it q(dies when cancelled) => sub {
+        throws_ok { async_cancel->run_until_completion_ref } qr/cancelled/;
+    };
+};
+
 done_testing;
@@ -0,0 +1,296 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use utf8;
+
+use FindBin;
+use lib "$FindBin::Bin/lib";
+
+use Async::Trampoline::Describe qw(describe it);
+use Test::More;
+use Test::Exception;
+
+use Async::Trampoline ':all';
+
+# Counts the Async_eval() calls needed to complete an Async.
+sub allocated_nodes { Async::Trampoline::_stats()->{allocated_nodes} }
+
+sub eval_steps {
+    my ($async) = @_;
+    my $before = Async::Trampoline::_stats()->{eval_steps};
+    my @result = $async->run_until_completion;
+    return Async::Trampoline::_stats()->{eval_steps} - $before, @result;
+}
+
+describe q(completed results) => sub {
+    it q(completes a thunk in a single step) => sub {
+        my ($steps, $result) = eval_steps(async { async_value "value" });
+        is $result, "value";
+        is $steps, 1;
+    };
+
+    it q(completes a thunk in a single step when shared) => sub {
+        my $shared = async_value "value";
+        my ($steps, $result) = eval_steps(async { $shared });
+        is $result, "value";
+        is $steps, 1;
+    };
+
+    it q(completes a flow in a single step after the dependency) => sub {
+        my $async = async_value(1)->value_then(async_value "value");
+        my ($steps, $result) = eval_steps($async);
+        is $result, "value";
+        is $steps, 1;
+    };
+
+    it q(completes a match in a single step) => sub {
+        my $async = async_value(1)->match(value => sub { async_value "value" });
+        my ($steps, $result) = eval_steps($async);
+        is $result, "value";
+        is $steps, 1;
+    };
+
+    it q(completes a loop in a single step) => sub {
+        my ($steps, $result) = eval_steps(async_loop 0, sub { async_value "value" });
+        is $result, "value";
+        is $steps, 1;
+    };
+};
+
+describe q(construction with completed inputs) => sub {
+    it qq(selects the branch of $_->[0]) => sub {
+        my (undef, $make, $expected) = @$_;
+        my $left = async_value "left";
+        my $right = async { async_value "right" };
+        my $before = allocated_nodes();
+        my $async = $make->($left, $right);
+        is allocated_nodes(), $before, q(no Flow allocated);
+        is $async->run_until_completion, $expected;
+    } for
+        [value_then     => sub { $_[0]->value_then($_[1]) },    "right"],
+        [resolved_then  => sub { $_[0]->resolved_then($_[1]) }, "right"],
+        [complete_then  => sub { $_[0]->complete_then($_[1]) }, "right"],
+        [value_or       => sub { $_[0]->value_or($_[1]) },      "left"],
+        [resolved_or    => sub { $_[0]->resolved_or($_[1]) },   "left"];
+
+    it q(keeps the Flow for incomplete inputs) => sub {
+        my $async = (async { async_cancel })->resolved_or(async_value "right");
+        ok !$async->is_complete;
+        is $async->run_until_completion, "right";
+    };
+
+    it q(concatenates values right away) => sub {
+        my $async = async_value(1, 2)->concat(async_value 3);
+        ok $async->is_value;
+        is join(" ", $async->run_until_completion), "1 2 3";
+    };
+
+    it q(propagates cancellation right away) => sub {
+        my $async = async_cancel->concat(async { async_value 1 });
+        ok $async->is_cancelled;
+    };
+
+    it q(propagates errors right away) => sub {
+        my $async = (async { async_value 1 })->concat(async_error "oops\n");
+        ok $async->is_error;
+        throws_ok { $async->run_until_completion } qr/\Aoops$/;
+    };
+
+    it q(folds await() dependencies) => sub {
+        my $async = await [async_value(1), async_value(2)], sub {
+            async_value join " ", @_;
+        };
+        is $async->run_until_completion, "1 2";
+    };
+};
+
+describe q(chained flows) => sub {
+    it q(builds a single node) => sub {
+        my @steps = map { my $i = $_; async { async_value $i } } 1 .. 4;
+        my $before = allocated_nodes();
+        my $async = $steps[0]
+            ->value_then($steps[1])
+            ->value_then($steps[2])
+            ->value_then($steps[3]);
+        is allocated_nodes() - $before, 1, q(one node for the chain);
+        is $async->run_until_completion, 4;
+    };
+
+    it q(stops at the first step that fails the decision) => sub {
+        my $async = (async { async_value 1 })
+            ->value_then(async { async_error "oops\n" })
+            ->value_then(async { die "not reached" })
+            ->value_then(async_value 4);
+        throws_ok { $async->run_until_completion } qr/\Aoops$/;
+    };
+
+    it q(works with resolved_or()) => sub {
+        my $async = (async { async_cancel })
+            ->resolved_or(async { async_cancel })
+            ->resolved_or(async { async_value "found" })
+            ->resolved_or(async { die "not reached" });
+        is $async->run_until_completion, "found";
+    };
+
+    it q(can mix decisions) => sub {
+        my $async = (async { async_cancel })
+            ->complete_then(async { async_error "oops\n" })
+            ->value_then(async { die "not reached" })
+            ->value_or(async_value "fallback")
+            ->resolved_or(async { die "not reached" });
+        is $async->run_until_completion, "fallback";
+    };
+
+    it q(doesn't modify named Asyncs) => sub {
+        my $first = (async { async_value 1 })->value_then(async_value 2);
+        my $second = $first->value_then(async_value 3);
+        my $third = $second->value_then(async_value 4)->value_then(async_value 5);
+        is $third->run_until_completion, 5;
+        is $second->run_until_completion, 3;
+        is $first->run_until_completion, 2;
+    };
+};
+
+describe q(unreferenced work) => sub {
+    sub dropped_nodes { Async::Trampoline::_stats()->{dropped_nodes} }
+
+    it q(keeps evaluating the Async when callbacks drop it) => sub {
+        my $async;
+        my $inner = async { undef $async; async_value 1 };
+        $async = $inner->value_then(async_value 2);
+        undef $inner;
+
+        my $before = dropped_nodes();
+        is $async->run_until_completion, 2;
+        is dropped_nodes(), $before, q(nothing dropped);
+    };
+
+    it q(doesn't drop shared work) => sub {
+        my $shared = async { async_value "shared" };
+        my $async = $shared->value_then(async { $shared });
+
+        my $before = dropped_nodes();
+        is $async->run_until_completion, "shared";
+        is dropped_nodes(), $before, q(nothing dropped);
+    };
+};
+
+describe q(refcount traffic) => sub {
+    plan skip_all => q(needs -DASYNC_TRAMPOLINE_REFCOUNT_STATS=1)
+        if not exists Async::Trampoline::_stats()->{refcount_ops};
+
+    it q(doesn't touch refcounts when a loop runs in place) => sub {
+        my $async = async_loop 0, sub {
+            my ($i) = @_;
+            return async_value $i if $i >= 1000;
+            return async_continue $i + 1;
+        };
+        my $before = Async::Trampoline::_stats()->{refcount_ops};
+        is $async->run_until_completion, 1000;
+        my $ops = Async::Trampoline::_stats()->{refcount_ops} - $before;
+        cmp_ok $ops, '<', 10, q(constant number of refcount operations);
+    };
+};
+
+describe q(callbacks in the run loop) => sub {
+    our $dynamic = "outer";
+
+    it q(captures errors per callback) => sub {
+        my @seen;
+        my $async = async_all(
+            async { die "first\n" }->value_or(async_value "recovered"),
+            async { push @seen, $dynamic; async_value "second" },
+        );
+        is_deeply [$async->run_until_completion], ["recovered", "second"];
+        is_deeply \@seen, ["outer"], q(later callbacks are unaffected);
+    };
+
+    it q(restores local() changes after each callback) => sub {
+        my @seen;
+        my $async = async { local $dynamic = "inner"; async_value }
+            ->value_then(async { push @seen, $dynamic; async_value });
+        $async->run_until_completion;
+        is_deeply \@seen, ["outer"];
+    };
+
+    it q(can run nested loops) => sub {
+        my $async = async {
+            my $inner = async { async_value 1 };
+            async_value $inner->run_until_completion + 1;
+        };
+        is $async->run_until_completion, 2;
+    };
+
+    it q(recovers from callbacks that don't return an Async) => sub {
+        throws_ok { async { "not an Async" }->run_until_completion }
+            qr/must return another Async/;
+        is async { async_value "ok" }->run_until_completion, "ok",
+            q(next run works);
+    };
+
+    it q(leaves the scope after callbacks that don't return an Async) => sub {
+        my $scope;
+        my $async = async_scope {
+            ($scope) = @_;
+            async { "not an Async" };
+        };
+        throws_ok { $async->run_until_completion }
+            qr/must return another Async/;
+
+        my $outside = async { async_value "outside" };
+        $scope->cancel;
+        ok !$outside->is_cancelled, q(later Asyncs are not in the scope);
+        is $outside->run_until_completion, "outside";
+    };
+
+    it q(recovers from runs aborted by an exception) => sub {
+        my $scope;
+        my $pending = async_scope {
+            ($scope) = @_;
+            async_loop 0, sub { async_continue $_[0] + 1 };
+        };
+        my $broken = async { async_value "not a generator" }->gen_collect;
+        throws_ok { async_all($pending, $broken)->run_until_completion }
+            qr/generator Async must have Async as first value/;
+
+        $scope->cancel;
+        ok $pending->is_cancelled, q(cancelled outside of a run);
+        is_deeply [
+            async_all(async { async_value 1 }, async { async_value 2 })
+                ->run_until_completion
+        ], [1, 2], q(next run works);
+    };
+};
+
+describe q(async_all() across runs) => sub {
+    # a loop that takes several turns of the run loop
+    my $slow_value = sub {
+        my ($value) = @_;
+        return async_loop 0, sub {
+            my ($i) = @_;
+            return async_value $value if $i >= 1_000;
+            return async_continue $i + 1;
+        };
+    };
+
+    it q(completes in a nested run after an outer run started it) => sub {
+        my $select = async_all($slow_value->("slow"), async { async_value 1 });
+        my $async = async_all(
+            $select,
+            async { async_value $select->run_until_completion_ref },
+        );
+        is_deeply [$async->run_until_completion],
+            ["slow", 1, ["slow", 1]];
+    };
+
+    it q(completes when run again after an aborted run) => sub {
+        my $select = async_all($slow_value->("slow"), async { async_value 1 });
+        my $broken = async { async_value "not a generator" }->gen_collect;
+        throws_ok { async_all($select, $broken)->run_until_completion }
+            qr/generator Async must have Async as first value/;
+        is_deeply [$select->run_until_completion], ["slow", 1];
+    };
+};
+
+done_testing;
@@ -0,0 +1,200 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use utf8;
+
+use FindBin;
+use lib "$FindBin::Bin/lib";
+
+use Async::Trampoline::Describe qw(describe it);
+use Test::More;
+use Test::Exception;
+
+use Async::Trampoline ':all';
+
+# Long-running loops must not accumulate Async nodes.
+# The stream length can be increased for extended testing.
+my $STREAM_SIZE = $ENV{EXTENDED_TESTING} ? 10_000_000 : 100_000;
+my $SAMPLE_EVERY = $STREAM_SIZE / 100;
+
+sub live_nodes { Async::Trampoline::_stats()->{live_nodes} }
+
+sub naturals {
+    my ($i) = @_;
+    return async_yield async_value($i) => sub {
+        return naturals($i + 1);
+    };
+}
+
+# Consume an infinite stream, sampling the live node count along the way.
+# Returns the samples, excluding the warmup phase.
+#
+# Takes a generator constructor, because holding on to the head of the stream
+# would keep all consumed items alive.
+sub sample_live_nodes_while_streaming {
+    my ($make_gen) = @_;
+    my @samples;
+    my $async = $make_gen->()->gen_foreach(sub {
+        my ($i) = @_;
+        return async_cancel if $i >= $STREAM_SIZE;
+        push @samples, live_nodes() if $i > 0 && $i % $SAMPLE_EVERY == 0;
+        return async_value;
+    });
+    $async->run_until_completion;
+    return @samples;
+}
+
+describe q(generators) => sub {
+    it q(gen_foreach() runs in constant memory) => sub {
+        my @samples = sample_live_nodes_while_streaming(sub { naturals(0) });
+
+        is 0+@samples, 99, q(saw the whole stream);
+        my ($min, $max) = (sort { $a <=> $b } @samples)[0, -1];
+        is $max, $min, q(live node count is flat)
+            or diag "samples: @samples";
+    };
+
+    it q(gen_map() runs in constant memory) => sub {
+        my @samples = sample_live_nodes_while_streaming(sub {
+            naturals(0)->gen_map(sub { async_value @_ });
+        });
+
+        is 0+@samples, 99, q(saw the whole stream);
+        my ($min, $max) = (sort { $a <=> $b } @samples)[0, -1];
+        is $max, $min, q(live node count is flat)
+            or diag "samples: @samples";
+    };
+
+    it q(gen_foreach() releases all nodes when done) => sub {
+        my $before = live_nodes();
+        sample_live_nodes_while_streaming(sub { naturals(0) });
+        is live_nodes(), $before, q(no nodes leaked);
+    };
+};
+
+describe q(tail-recursive async loops) => sub {
+    our @shared;
+
+    # the documented loop_async pattern,
+    # optionally keeping an extra reference to the result
+    sub count_down_async {
+        my ($i, $samples, $share) = @_;
+        push @$samples, live_nodes()
+            if 0 < $i && $i < $STREAM_SIZE && $i % $SAMPLE_EVERY == 0;
+        return async_value "done" if not $i;
+        my $next = async { count_down_async($i - 1, $samples, $share) };
+        $shared[0] = $next if $share;
+        return $next;
+    }
+
+    it qq(runs in constant memory with $_->[0] results) => sub {
+        my (undef, $share) = @$_;
+        my @samples;
+        my $async = count_down_async($STREAM_SIZE, \@samples, $share);
+        is $async->run_until_completion, "done", q(loop completed);
+
+        is 0+@samples, 99, q(saw all iterations);
+        my ($min, $max) = (sort { $a <=> $b } @samples)[0, -1];
+        is $max, $min, q(live node count is flat)
+            or diag "samples: @samples";
+    } for
+        [unique => 0],
+        [shared => 1];
+
+    @shared = ();
+};
+
+describe q(Ptr forwarding) => sub {
+    it q(redirects references to shared results) => sub {
+        my $shared = async_value "shared";
+        my $step;
+        $step = sub {
+            my ($i) = @_;
+            return async_value "done" if not $i;
+            my $x = async { $shared };
+            return $x->value_then(async { $step->($i - 1) });
+        };
+
+        my $before = Async::Trampoline::_stats()->{ptr_hops};
+        is $step->($SAMPLE_EVERY)->run_until_completion, "done",
+            q(loop completed);
+        my $stats = Async::Trampoline::_stats();
+        undef $step;
+
+        cmp_ok $stats->{ptr_chain_max}, '<=', 1, q(Ptr chains are flat);
+        cmp_ok $stats->{ptr_hops} - $before, '<=', 2 * $SAMPLE_EVERY,
+            q(bounded Ptr hops per iteration);
+    };
+};
+
+describe q(async_loop()) => sub {
+    it q(does not allocate Asyncs per iteration) => sub {
+        my $async = async_loop 0, sub {
+            my ($i) = @_;
+            return async_value $i if $i >= $STREAM_SIZE;
+            return async_continue $i + 1;
+        };
+        my $before = Async::Trampoline::_stats()->{allocated_nodes};
+        is $async->run_until_completion, $STREAM_SIZE, q(loop completed);
+        my $after = Async::Trampoline::_stats()->{allocated_nodes};
+        cmp_ok $after - $before, '<=', 1, q(only the result was allocated);
+    };
+};
+
+describe q(node layout) => sub {
+    it q(shares Cancel and empty Values instead of allocating them) => sub {
+        my $before = Async::Trampoline::_stats()->{allocated_nodes};
+        my @shared = map { (async_cancel, async_value) } 1 .. 10;
+        my $after = Async::Trampoline::_stats()->{allocated_nodes};
+        is $after - $before, 0, q(no allocations);
+
+        my $async = async_value->value_then(
+            async_cancel->resolved_or(async_value));
+        is_deeply [$async->run_until_completion], [],
+            q(shared Asyncs can be combined);
+        ok $shared[0]->is_cancelled, q(Cancel is still Cancel);
+        ok $shared[1]->is_value, q(empty Value is still a Value);
+    };
+
+    it q(lets shared values be used like any other) => sub {
+        my $value = async_value 1, 2;
+        my $async = async { $value }->concat($value)->value_then($value);
+        is_deeply [$async->run_until_completion], [1, 2],
+            q(completed with the shared value);
+    };
+};
+
+describe q(destruction) => sub {
+    # deep enough to overflow the C stack if nodes were deleted recursively
+    my $DEPTH = 1_000_000;
+
+    it q(releases deep chains of Asyncs) => sub {
+        my $before = live_nodes();
+        {
+            # a pending head, so that the chain isn't resolved while built
+            my $async = async { async_value 1 };
+            $async = $async->value_then(async { async_value 1 })
+                for 1 .. $DEPTH;
+            cmp_ok live_nodes() - $before, '>', $DEPTH,
+                q(the chain is alive);
+        }
+        is live_nodes(), $before, q(all nodes released);
+    };
+
+    it q(releases a consumed generator that is still referenced) => sub {
+        my $before = live_nodes();
+        {
+            my $gen = naturals(0);
+            my $async = $gen->gen_foreach(sub {
+                my ($i) = @_;
+                return async_cancel if $i >= $STREAM_SIZE;
+                return async_value;
+            });
+            $async->run_until_completion;
+        }
+        is live_nodes(), $before, q(all nodes released);
+    };
+};
+
+done_testing;
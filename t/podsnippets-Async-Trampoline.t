@@ -9,34 +9,39 @@ use Test::Output;
     use feature 'say';
 
 
-#line 67 lib/Async/Trampoline.pm
+#line 74 lib/Async/Trampoline.pm
 use Async::Trampoline qw(
     await
     async async_value async_error async_cancel
+    async_loop async_continue
+    async_scope
+    async_all async_any async_race
     async_yield
 );
 
 ;
 
-#line 73 lib/Async/Trampoline.pm
+#line 83 lib/Async/Trampoline.pm
 use Async::Trampoline ':all';
 
 ;
 
-#line 75 lib/Async/Trampoline.pm
+#line 85 lib/Async/Trampoline.pm
 ;
 
-#line 78 lib/Async/Trampoline.pm
+#line 88 lib/Async/Trampoline.pm
 $async = async_value 1, 2, 3;
 $async = async_error "oops";
 $async = async_cancel;
 $async = async { ...; return $new_async };
+$async = async_loop $state, sub { ...; return async_continue $new_state };
+$async = async_scope { my ($scope) = @_; ...; return $new_async };
 
 ;
 $async = async_value 1, 2, 3;
 
 
-#line 88 lib/Async/Trampoline.pm
+#line 100 lib/Async/Trampoline.pm
 @result = $async->run_until_completion;
 
 ;
@@ -48,7 +53,7 @@ $other_async = async { async_value "other async" };
     $y = async_value "y";
 
 
-#line 101 lib/Async/Trampoline.pm
+#line 113 lib/Async/Trampoline.pm
 $async = $other_async->await(sub {
     my (@values) = @_;
     # ...
@@ -57,7 +62,7 @@ $async = $other_async->await(sub {
 
 ;
 
-#line 107 lib/Async/Trampoline.pm
+#line 119 lib/Async/Trampoline.pm
 $async = await [$x, $y] => sub {
     my (@x_and_y_values) = @_;
     # ...
@@ -66,7 +71,7 @@ $async = await [$x, $y] => sub {
 
 ;
 
-#line 113 lib/Async/Trampoline.pm
+#line 125 lib/Async/Trampoline.pm
 $async = $x->complete_then($y);
 $async = $x->resolved_or($y);
 $async = $x->resolved_then($y);
@@ -75,12 +80,29 @@ $async = $x->value_then($y);
 
 ;
 
-#line 119 lib/Async/Trampoline.pm
+#line 131 lib/Async/Trampoline.pm
 $async = $x->concat($y);
 
 ;
 
-#line 123 lib/Async/Trampoline.pm
+#line 133 lib/Async/Trampoline.pm
+$async = async_all $x, $y;
+$async = async_any $x, $y;
+$async = async_race $x, $y;
+
+;
+
+#line 137 lib/Async/Trampoline.pm
+$async = $x->match(
+    value   => sub { my (@values) = @_; return $new_async },
+    error   => sub { my ($error) = @_; return $new_async },
+    cancel  => sub { return $new_async },
+);
+$async = $x->finally(sub { ... });
+
+;
+
+#line 146 lib/Async/Trampoline.pm
 $gen = async_yield async_value(1, 2, 3) => sub {
     # ...
     return $next_generator;
@@ -88,7 +110,7 @@ $gen = async_yield async_value(1, 2, 3) => sub {
 
 ;
 
-#line 128 lib/Async/Trampoline.pm
+#line 151 lib/Async/Trampoline.pm
 $gen = $gen->gen_map(sub {
     my (@values) = @_;
     # ...
@@ -97,7 +119,7 @@ $gen = $gen->gen_map(sub {
 
 ;
 
-#line 134 lib/Async/Trampoline.pm
+#line 157 lib/Async/Trampoline.pm
 $async = $gen->gen_foreach(sub {
     my (@values) = @_;
     return async_cancel if not @values;  # like "last" in Perl
@@ -107,17 +129,17 @@ $async = $gen->gen_foreach(sub {
 
 ;
 
-#line 141 lib/Async/Trampoline.pm
+#line 164 lib/Async/Trampoline.pm
 $async = $gen->gen_collect;
 
 ;
 
-#line 145 lib/Async/Trampoline.pm
+#line 168 lib/Async/Trampoline.pm
 $str = $async->to_string;
 
 ;
 
-#line 147 lib/Async/Trampoline.pm
+#line 170 lib/Async/Trampoline.pm
 $bool = $async->is_complete;
 $bool = $async->is_cancelled;
 $bool = $async->is_error;
@@ -125,12 +147,12 @@ $bool = $async->is_value;
 
 ;
 
-#line 177 lib/Async/Trampoline.pm
+#line 200 lib/Async/Trampoline.pm
 my @items;
 
 ;
 
-#line 179 lib/Async/Trampoline.pm
+#line 202 lib/Async/Trampoline.pm
 my $i = 5;
 while ($i) {
     push @items, $i--;
@@ -140,7 +162,7 @@ while ($i) {
 is "@items", "5 4 3 2 1", q(Synchronous/imperative);
 
 
-#line 189 lib/Async/Trampoline.pm
+#line 212 lib/Async/Trampoline.pm
 sub loop {
     my ($items, $i) = @_;
     return $items if not $i;
@@ -150,14 +172,14 @@ sub loop {
 
 ;
 
-#line 196 lib/Async/Trampoline.pm
+#line 219 lib/Async/Trampoline.pm
 my $items = loop([], 5);
 
 ;
 is "@$items", "5 4 3 2 1", q(Synchronous/recursive);
 
 
-#line 203 lib/Async/Trampoline.pm
+#line 226 lib/Async/Trampoline.pm
 sub loop_async {
     my ($items, $i) = @_;
     return async_value $items if not $i;
@@ -167,14 +189,27 @@ sub loop_async {
 
 ;
 
-#line 210 lib/Async/Trampoline.pm
+#line 233 lib/Async/Trampoline.pm
 my $items = loop_async([], 5)->run_until_completion;
 
 ;
 is "@$items", "5 4 3 2 1", q(Async/recursive);
 
 
-#line 217 lib/Async/Trampoline.pm
+#line 240 lib/Async/Trampoline.pm
+my @items;
+async_loop(5, sub {
+    my ($i) = @_;
+    return async_value if not $i;
+    push @items, $i;
+    return async_continue $i - 1;
+})->run_until_completion;
+
+;
+is "@items", "5 4 3 2 1", q(Async/loop);
+
+
+#line 253 lib/Async/Trampoline.pm
 sub loop_gen {
     my ($i) = @_;
     return async_cancel if not $i;
@@ -185,37 +220,71 @@ sub loop_gen {
 
 ;
 
-#line 225 lib/Async/Trampoline.pm
+#line 261 lib/Async/Trampoline.pm
 my $items = loop_gen(5)->gen_collect->run_until_completion;
 
 ;
 is "@$items", "5 4 3 2 1", q(Async/generators);
 
  
-#line 282 lib/Async/Trampoline.pm
+#line 318 lib/Async/Trampoline.pm
 $async = async { ... };
 
 ;
 
-#line 291 lib/Async/Trampoline.pm
+#line 327 lib/Async/Trampoline.pm
 $async = async_value @values;
 
 ;
+$value = "original";
+
+
+#line 340 lib/Async/Trampoline.pm
+$async = async_value_alias $value;
+
+;
+$value = "changed";
+    is $async->run_until_completion, "changed", q(async_value_alias());
 
-#line 298 lib/Async/Trampoline.pm
+
+#line 353 lib/Async/Trampoline.pm
 $async = async_error $error;
 
 ;
 
-#line 307 lib/Async/Trampoline.pm
+#line 362 lib/Async/Trampoline.pm
 $async = async_cancel;
 
+;
+
+#line 369 lib/Async/Trampoline.pm
+$async = async_loop $initial_state, sub {
+    my ($state) = @_;
+    return async_continue $next_state if $keep_going;
+    return $result_async;
+};
+
+;
+ 
+#line 397 lib/Async/Trampoline.pm
+my $scope;
+$async = async_scope {
+    ($scope) = @_;
+    # ...
+    return $new_async;
+};
+
+;
+
+#line 404 lib/Async/Trampoline.pm
+$scope->cancel;
+
 ;
 $dependency = async { async_value 1,2, 3 };
     @dependencies = (async_value(1), async_value(), async_value(3));
 
 
-#line 320 lib/Async/Trampoline.pm
+#line 432 lib/Async/Trampoline.pm
 $async = $dependency->await(sub {
     my (@result) = @_;
     # ...
@@ -224,7 +293,7 @@ $async = $dependency->await(sub {
 
 ;
 
-#line 326 lib/Async/Trampoline.pm
+#line 438 lib/Async/Trampoline.pm
 $async = await $dependency => sub {
     my (@result) = @_;
     # ...
@@ -233,7 +302,7 @@ $async = await $dependency => sub {
 
 ;
 
-#line 332 lib/Async/Trampoline.pm
+#line 444 lib/Async/Trampoline.pm
 $async = await [@dependencies] => sub {
     my (@results) = @_;
     # ...
@@ -246,25 +315,25 @@ $first_async = async { async_value };
     $second_async = $alternative_async;
 
 
-#line 355 lib/Async/Trampoline.pm
+#line 467 lib/Async/Trampoline.pm
 $async = $first_async->resolved_or($alternative_async);
 $async = $first_async->value_or($alternative_async);
 
 ;
 
-#line 376 lib/Async/Trampoline.pm
+#line 488 lib/Async/Trampoline.pm
 $async = $first_async->complete_then($second_async);
 $async = $first_async->resolved_then($second_async);
 $async = $first_async->value_then($second_async);
 
 ;
 
-#line 403 lib/Async/Trampoline.pm
+#line 515 lib/Async/Trampoline.pm
 $async = $first_async->concat($second_async);
 
 ;
 
-#line 409 lib/Async/Trampoline.pm
+#line 521 lib/Async/Trampoline.pm
 $async = (async_value 1, 2, 3)->concat(async_value 4, 5);
 #=> async_value 1, 2, 3, 4, 5
 
@@ -274,7 +343,47 @@ $async = (async_value 1, 2, 3)->concat(async_value 4, 5);
 }
 
 
-#line 436 lib/Async/Trampoline.pm
+#line 535 lib/Async/Trampoline.pm
+$async = async_all @asyncs;
+$async = async_any @asyncs;
+$async = async_race @asyncs;
+
+;
+
+#line 573 lib/Async/Trampoline.pm
+$async = async_any async_error("unavailable"), async { async_value "found" };
+#=> async_value "found"
+
+;
+{ is $async->run_until_completion, "found", q(async_any());
+}
+
+
+#line 582 lib/Async/Trampoline.pm
+$async = $dependency->match(
+    value   => sub { my (@values) = @_; ... },
+    error   => sub { my ($error) = @_; ... },
+    cancel  => sub { ... },
+);
+
+;
+
+#line 599 lib/Async/Trampoline.pm
+$async = (async_error "oops")->match(
+    error => sub { async_value "recovered" },
+);
+
+;
+{ is $async->run_until_completion, "recovered", q(match());
+}
+
+
+#line 609 lib/Async/Trampoline.pm
+$async = $dependency->finally(sub { ... });
+
+;
+
+#line 636 lib/Async/Trampoline.pm
 sub count_down_generator {
     my ($i) = @_;
     return async_cancel if $i < 0;
@@ -285,12 +394,12 @@ sub count_down_generator {
 
 ;
 
-#line 444 lib/Async/Trampoline.pm
+#line 644 lib/Async/Trampoline.pm
 my $countdown_gen = count_down_generator(10);
 
 ;
 
-#line 448 lib/Async/Trampoline.pm
+#line 648 lib/Async/Trampoline.pm
 $countdown_gen = $countdown_gen->gen_map(sub {
     my ($i) = @_;
     return async_value "ignition" if $i == 3;
@@ -303,7 +412,7 @@ $result = $countdown_gen->gen_collect->run_until_completion;
     is "@$result", "10 9 8 7 6 5 4 ignition 2 1 liftoff", q(countdown map);
 
 
-#line 461 lib/Async/Trampoline.pm
+#line 661 lib/Async/Trampoline.pm
 my $finished_async = $countdown_gen->gen_foreach(sub {
     my ($i) = @_;
     say $i;
@@ -317,7 +426,7 @@ stdout_is { $result = $finished_async->run_until_completion }
     is $result, undef, q(countdown result);
 
 
-#line 475 lib/Async/Trampoline.pm
+#line 675 lib/Async/Trampoline.pm
 sub repeat_gen {
     my ($gen) = @_;
     return $gen->await(sub {
@@ -337,12 +446,12 @@ $result = repeat_gen(count_down_generator(2))
     is "@$result", "2 2 1 1 0 0", q(repetition);
 
 
-#line 495 lib/Async/Trampoline.pm
+#line 695 lib/Async/Trampoline.pm
 $generator = async_yield $async => sub { return $next_generator }
 
 ;
 
-#line 505 lib/Async/Trampoline.pm
+#line 705 lib/Async/Trampoline.pm
 $generator = $generator->gen_map(sub {
     my (@values) = @_;
     # ...
@@ -351,7 +460,7 @@ $generator = $generator->gen_map(sub {
 
 ;
 
-#line 523 lib/Async/Trampoline.pm
+#line 723 lib/Async/Trampoline.pm
 $async = $generator->gen_foreach(sub {
     my (@values) = @_;
     # ...
@@ -360,27 +469,36 @@ $async = $generator->gen_foreach(sub {
 
 ;
 
-#line 540 lib/Async/Trampoline.pm
+#line 740 lib/Async/Trampoline.pm
 $async = $generator->gen_collect;
 
 ;
 $async = async { async_value 1, 2, 3 };
 
 
-#line 552 lib/Async/Trampoline.pm
+#line 752 lib/Async/Trampoline.pm
 @result = $async->run_until_completion;
 
 ;
 is "@result", "1 2 3", q(run_until_completion());
 
+$async = async { async_value 1, 2, 3 };
+
+
+#line 776 lib/Async/Trampoline.pm
+$result = $async->run_until_completion_ref;
+
+;
+is "@$result", "1 2 3", q(run_until_completion_ref());
+
 
-#line 570 lib/Async/Trampoline.pm
+#line 786 lib/Async/Trampoline.pm
 $str = $async->to_string;
 $str = "$async";
 
 ;
 
-#line 585 lib/Async/Trampoline.pm
+#line 801 lib/Async/Trampoline.pm
 $bool = $async->is_complete;
 $bool = $async->is_cancelled;
 $bool = $async->is_resolved;
@@ -0,0 +1,106 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use utf8;
+
+use Config;
+use Test::More;
+
+BEGIN {
+    plan skip_all => q(needs a perl with ithreads)
+        if not $Config{useithreads};
+}
+
+# no imports: threads would export its own async()
+use threads ();
+
+use FindBin;
+use lib "$FindBin::Bin/lib";
+
+use Async::Trampoline::Describe qw(describe it);
+
+use Async::Trampoline ':all';
+
+# Each thread works on its own Asyncs.
+# No Asyncs may exist in the main thread while threads are created,
+# since the clones would share them.
+my $THREADS = 4;
+my $ITERATIONS = 1_000;
+
+sub in_threads {
+    my ($work) = @_;
+    my @threads = map { threads->create($work) } 1 .. $THREADS;
+    return [map { $_->join // 'died' } @threads];
+}
+
+describe q(threads) => sub {
+    it q(run value_then chains) => sub {
+        my $results = in_threads(sub {
+            my $ok = 0;
+            for my $i (1 .. $ITERATIONS) {
+                my $async = async { async_value $i };
+                $async = $async->value_then(async { async_value $i })
+                    for 1 .. 10;
+                my ($result) = $async->run_until_completion;
+                $ok++ if $result == $i;
+            }
+            return $ok;
+        });
+        is_deeply $results, [($ITERATIONS) x $THREADS],
+            q(all chains completed);
+    };
+
+    it q(release deep chains) => sub {
+        my $results = in_threads(sub {
+            my $async = async { async_value 1 };
+            $async = $async->value_then(async { async_value 1 })
+                for 1 .. 100_000;
+            undef $async;
+            return 1;
+        });
+        is_deeply $results, [(1) x $THREADS], q(all chains released);
+    };
+
+    it q(use scopes and shared results) => sub {
+        my $results = in_threads(sub {
+            my $ok = 0;
+            for my $i (1 .. $ITERATIONS) {
+                my $scope;
+                my $async = async_scope {
+                    ($scope) = @_;
+                    return async_race
+                        async { async_value $i },
+                        async { async_value $i }->value_then(async_cancel);
+                };
+                my ($result) = $async->run_until_completion;
+                $scope->cancel;
+                $ok++ if $result == $i
+                    && async_all()->is_complete
+                    && async_cancel->is_cancelled;
+            }
+            return $ok;
+        });
+        is_deeply $results, [($ITERATIONS) x $THREADS],
+            q(all scopes completed);
+    };
+
+    it q(count nodes per thread) => sub {
+        my $results = in_threads(sub {
+            my $ok = 0;
+            for my $i (1 .. $ITERATIONS) {
+                my $before = Async::Trampoline::_stats()->{live_nodes};
+                my @asyncs = map { async_value $_ } 1 .. 10;
+                my $live = Async::Trampoline::_stats()->{live_nodes};
+                @asyncs = ();
+                $ok++ if $live - $before == 10
+                    && Async::Trampoline::_stats()->{live_nodes} == $before;
+            }
+            return $ok;
+        });
+        is_deeply $results, [($ITERATIONS) x $THREADS],
+            q(each thread saw only its own nodes);
+    };
+};
+
+done_testing;